@@ -33,7 +33,10 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <fstream>
+#include <future>
 #include <json/json.h>
 
 using namespace std;
@@ -398,24 +401,64 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+namespace
+{
+
+/// @returns false if an assembly is reachable more than once from @a _assembly
+/// or is contained in @a _seen, which is extended by all reachable assemblies.
+bool subAssembliesDistinct(Assembly const& _assembly, set<Assembly const*>& _seen)
+{
+	for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+	{
+		Assembly const& sub = _assembly.sub(subId);
+		if (!_seen.insert(&sub).second || !subAssembliesDistinct(sub, _seen))
+			return false;
+	}
+	return true;
+}
+
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
 	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	set<Assembly const*> assembliesSeen;
+	if (_settings.concurrent && m_subs.size() > 1 && subAssembliesDistinct(*this, assembliesSeen))
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		// The sub-assemblies are independent, so optimise them concurrently. The replacements
+		// only affect tags of their respective sub-assembly and are applied in order afterwards.
+		// Their own sub-assemblies are optimised sequentially in the same worker.
+		subSettings.concurrent = false;
+		vector<future<map<u256, u256>>> subTagReplacements;
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			subTagReplacements.emplace_back(ThreadPool::shared().submit(
+				[sub = m_subs[subId], subSettings, referencedTags = JumpdestRemover::referencedTags(m_items, subId)]() mutable {
+					return sub->optimiseInternal(subSettings, move(referencedTags));
+				}
+			));
+		// Wait for all of them before an exception of one of them is rethrown,
+		// the others still modify the sub-assemblies.
+		for (auto& replacements: subTagReplacements)
+			replacements.wait();
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId].get(), subId);
 	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		{
+			map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
+				subSettings,
+				JumpdestRemover::referencedTags(m_items, subId)
+			);
+			// Apply the replacements (can be empty).
+			BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		}
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
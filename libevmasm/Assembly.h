@@ -119,6 +119,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Optimise independent sub-assemblies concurrently in the shared thread pool.
+		/// Does not change the result.
+		bool concurrent = false;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -27,8 +27,12 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <liblangutil/Exceptions.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -37,7 +41,7 @@ using namespace solidity::evmasm;
 
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
+	// Compares blocks based on the suffix that starts at their tag, ignoring tags and stopping at
 	// opcodes that stop the control flow.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
@@ -49,46 +53,53 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	BlockIterator end{m_items.end(), m_items.end()};
+	// @returns an iterator to the first item of the block that starts at the tag at _tagIndex.
+	// To compare recursive loops, PushTag items of the block's own tag (@a _pushOwnTag) are
+	// replaced by pushSelf.
+	auto blockBegin = [&](size_t _tagIndex, AssemblyItem const& _pushOwnTag)
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
 		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
+		BlockIterator it{m_items.begin() + diff_type(_tagIndex), m_items.end(), &_pushOwnTag, &pushSelf};
+		solAssert(it != end && (*it).type() == Tag, "");
+		return ++it;
+	};
+	auto blockHash = [&](size_t _tagIndex)
+	{
+		AssemblyItem pushOwnTag = m_items.at(_tagIndex).pushTag();
+		size_t hash = 0;
+		for (auto it = blockBegin(_tagIndex, pushOwnTag); it != end; ++it)
+		{
+			AssemblyItem const& item = *it;
+			boost::hash_combine(hash, static_cast<int>(item.type()));
+			if (item.type() == Operation)
+				boost::hash_combine(hash, static_cast<uint8_t>(item.instruction()));
+			else
+				// Only the lower bits of the data are used, which is enough for a hash.
+				boost::hash_combine(hash, static_cast<uint64_t>(item.data() & u256(numeric_limits<uint64_t>::max())));
+		}
+		return hash;
+	};
+	auto equalBlocks = [&](size_t _i, size_t _j)
+	{
+		AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+		AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
+		return std::equal(blockBegin(_i, pushFirstTag), end, blockBegin(_j, pushSecondTag), end);
 	};
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		// Blocks that are not equal to any earlier block, grouped by the hash of their content.
+		unordered_map<size_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[blockHash(i)];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) { return equalBlocks(i, _j); });
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
@@ -24,10 +24,57 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// Cache of the routines found by ComputeMethod, shared by all assemblies.
+class RepresentationCache
+{
+public:
+	/// Value, whether it is creation code, runs, multiplicity and EVM version.
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+
+	static RepresentationCache& instance()
+	{
+		static RepresentationCache cache;
+		return cache;
+	}
+
+	optional<AssemblyItems> find(Key const& _key)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (auto it = m_entries.find(_key); it != m_entries.end())
+			return it->second;
+		return nullopt;
+	}
+
+	void insert(Key _key, AssemblyItems _routine)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		// Most constants are specific to a contract, so bound the size.
+		if (m_entries.size() >= maxEntries)
+			m_entries.clear();
+		m_entries.emplace(move(_key), move(_routine));
+	}
+
+private:
+	static size_t constexpr maxEntries = 16384;
+
+	mutex m_mutex;
+	map<Key, AssemblyItems> m_entries;
+};
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -187,6 +234,25 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	// The routine only depends on the value and the parameters.
+	RepresentationCache::Key key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	if (optional<AssemblyItems> routine = RepresentationCache::instance().find(key))
+		m_routine = move(*routine);
+	else
+	{
+		m_routine = findRepresentation(m_value);
+		assertThrow(
+			checkRepresentation(m_value, m_routine),
+			OptimizerException,
+			"Invalid constant expression created."
+		);
+		RepresentationCache::instance().insert(move(key), m_routine);
+	}
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
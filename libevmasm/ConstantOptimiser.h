@@ -127,20 +127,13 @@ protected:
 
 /**
  * Method that tries to compute the constant.
+ * The same constants appear in many contracts, so the representations found are
+ * cached for the whole process.
  */
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
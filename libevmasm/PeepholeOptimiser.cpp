@@ -25,6 +25,9 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+#include <optional>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -81,6 +84,8 @@ struct ApplyRule<Method, 1>
 template <class Method, size_t WindowSize>
 struct SimplePeepholeOptimizerMethod
 {
+	static size_t constexpr windowSize = WindowSize;
+
 	static bool apply(OptimiserState& _state)
 	{
 		if (
@@ -337,6 +342,9 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	/// Removes more items, but whether it applies only depends on the first two.
+	static size_t constexpr windowSize = 2;
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -379,31 +387,78 @@ void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 		applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// The methods of the optimiser in the order in which they are tried.
+template <typename... Method>
+struct Methods
+{
+	/// The maximum number of items any method looks at to decide whether it applies.
+	static size_t constexpr maxWindowSize = max({Method::windowSize...});
+
+	static void apply(OptimiserState& _state)
+	{
+		applyMethods(_state, Method()...);
+	}
+};
+
+using PeepholeMethods = Methods<
+	PushPop, OpPop, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+	DupSwap, IsZeroIsZeroJumpI, JumpToNext, UnreachableCode,
+	TagConjunctions, TruthyAnd, Identity
+>;
+
+size_t numberOfPops(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+{
+	return static_cast<size_t>(std::count(_begin, _end, Instruction::POP));
+}
+
+size_t bytesRequiredInRange(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end, size_t _addressLength)
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
+	size_t size = 0;
+	for (auto it = _begin; it != _end; ++it)
+		size += it->bytesRequired(_addressLength);
+	return size;
 }
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
+	// The items before m_startPosition are the same as in the previous pass, where no method
+	// applied to them (apart from Identity), and the methods only look at the next
+	// maxWindowSize items to decide whether they apply. Thus, this pass would not change
+	// them either and we can start at m_startPosition.
+	size_t constexpr maxWindowSize = PeepholeMethods::maxWindowSize;
+	assertThrow(m_startPosition <= m_items.size(), OptimizerException, "");
+	m_optimisedItems.clear();
+	OptimiserState state {m_items, m_startPosition, std::back_inserter(m_optimisedItems)};
+	optional<size_t> firstChange;
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
+	{
+		size_t position = state.i;
+		PeepholeMethods::apply(state);
+		// All methods apart from Identity consume more than one item.
+		if (!firstChange && state.i != position + 1)
+			firstChange = position;
+	}
+
+	// Only the part starting at m_startPosition can differ, so it is sufficient to compare that part.
+	auto const start = m_items.begin() + static_cast<ptrdiff_t>(m_startPosition);
+	size_t const oldSize = m_items.size() - m_startPosition;
+	if (m_optimisedItems.size() < oldSize || (
+		m_optimisedItems.size() == oldSize && (
+			evmasm::bytesRequired(m_optimisedItems, 3) < bytesRequiredInRange(start, m_items.end(), 3) ||
+			numberOfPops(m_optimisedItems.begin(), m_optimisedItems.end()) > numberOfPops(start, m_items.end())
 		)
 	))
 	{
-		m_items = std::move(m_optimisedItems);
+		assertThrow(firstChange, OptimizerException, "");
+		m_items.erase(start, m_items.end());
+		m_items.insert(
+			m_items.end(),
+			make_move_iterator(m_optimisedItems.begin()),
+			make_move_iterator(m_optimisedItems.end())
+		);
+		m_startPosition = *firstChange - min(*firstChange, maxWindowSize - 1);
 		return true;
 	}
 	else
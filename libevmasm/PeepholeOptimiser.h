@@ -44,11 +44,18 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs one pass over the items.
+	/// @returns true if the items were changed.
+	/// Repeated calls only process the part of the items that can be affected by
+	/// changes of the previous pass.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	/// Position in m_items up to which the previous pass did not change anything
+	/// and where the next pass can start.
+	size_t m_startPosition = 0;
 };
 
 }
@@ -293,28 +293,55 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 		pair<string_view, int>{"\xE2\x80\xAC", -1} // U+202C (PDF - Pop Directional Formatting
 	};
 
-	size_t endPosition = _stream.position();
-	_stream.setPosition(_startPosition);
+	string_view source = _stream.source();
+	// All sequences start with the same byte, which is rare in the input, so only
+	// the positions of this byte in the scanned range have to be checked.
+	string_view range = source.substr(0, _stream.position());
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	for (
+		size_t currentPos = range.find('\xE2', _startPosition);
+		currentPos != string_view::npos;
+		currentPos = range.find('\xE2', currentPos + 1)
+	)
 	{
-		_stream.setPosition(currentPos);
-
+		string_view candidate = source.substr(currentPos);
 		for (auto const& [sequence, depthChange]: directionalSequences)
-			if (_stream.prefixMatch(sequence))
+			// Sequences ending exactly at the end of the input are not matched, like in CharStream::prefixMatch.
+			if (candidate.size() > sequence.size() && candidate.substr(0, sequence.size()) == sequence)
 				directionOverrideDepth += depthChange;
 
 		if (directionOverrideDepth < 0)
+		{
+			// Scanning continues at the offending sequence.
+			_stream.setPosition(currentPos);
 			return ScannerError::DirectionalOverrideUnderflow;
+		}
 	}
 
-	_stream.setPosition(endPosition);
-
 	return directionOverrideDepth > 0 ? ScannerError::DirectionalOverrideMismatch : ScannerError::NoError;
 }
 
+/// @returns true iff there is a unicode line break at position @a _position of @a _source.
+bool isUnicodeLinebreakAt(string_view _source, size_t _position)
+{
+	uint8_t c = static_cast<uint8_t>(_source[_position]);
+	if (0x0a <= c && c <= 0x0d)
+		// line feed, vertical tab, form feed, carriage return
+		return true;
+	if (c == 0xc2 && _position + 1 < _source.size() && uint8_t(_source[_position + 1]) == 0x85)
+		// NEL - U+0085, C2 85 in utf8
+		return true;
+	if (c == 0xe2 && _position + 2 < _source.size() && uint8_t(_source[_position + 1]) == 0x80 && (
+		uint8_t(_source[_position + 2]) == 0xa8 || uint8_t(_source[_position + 2]) == 0xa9
+	))
+		// LS - U+2028, E2 80 A8  in utf8
+		// PS - U+2029, E2 80 A9  in utf8
+		return true;
+	return false;
+}
+
 }
 
 Token Scanner::skipSingleLineComment()
@@ -322,9 +349,11 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source->position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
-			break;
+	string_view source = m_source->source();
+	size_t endPosition = startPosition;
+	while (endPosition < source.size() && !isUnicodeLinebreakAt(source, endPosition))
+		++endPosition;
+	m_char = m_source->setPosition(endPosition);
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -402,26 +431,23 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source->position();
-	while (!isSourcePastEndOfInput())
+	size_t terminatorPosition = m_source->source().find("*/", startPosition);
+	if (terminatorPosition == string::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source->setPosition(m_source->source().size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_char = m_source->setPosition(terminatorPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -816,19 +842,7 @@ bool Scanner::scanEscape()
 
 bool Scanner::isUnicodeLinebreak()
 {
-	if (0x0a <= m_char && m_char <= 0x0d)
-		// line feed, vertical tab, form feed, carriage return
-		return true;
-	if (!m_source->isPastEndOfInput(1) && uint8_t(m_source->get(0)) == 0xc2 && uint8_t(m_source->get(1)) == 0x85)
-		// NEL - U+0085, C2 85 in utf8
-		return true;
-	if (!m_source->isPastEndOfInput(2) && uint8_t(m_source->get(0)) == 0xe2 && uint8_t(m_source->get(1)) == 0x80 && (
-		uint8_t(m_source->get(2)) == 0xa8 || uint8_t(m_source->get(2)) == 0xa9
-	))
-		// LS - U+2028, E2 80 A8  in utf8
-		// PS - U+2029, E2 80 A9  in utf8
-		return true;
-	return false;
+	return !isSourcePastEndOfInput() && isUnicodeLinebreakAt(m_source->source(), sourcePos());
 }
 
 Token Scanner::scanString(bool const _isUnicode)
@@ -1021,10 +1035,17 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	// Scan the identifier directly in the source and copy it to the literal in one go.
+	string const& source = m_source->source();
+	size_t const startPosition = sourcePos();
+	size_t endPosition = startPosition + 1;
+	while (
+		endPosition < source.size() &&
+		(isIdentifierPart(source[endPosition]) || (source[endPosition] == '.' && m_kind == ScannerKind::Yul))
+	)
+		++endPosition;
+	m_char = m_source->setPosition(endPosition);
+	m_tokens[NextNext].literal.assign(source, startPosition, endPosition - startPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
@@ -41,7 +41,10 @@
 // along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <liblangutil/Token.h>
-#include <map>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 using namespace std;
 
@@ -115,17 +118,76 @@ std::string friendlyName(Token tok)
 }
 
 
-static Token keywordByName(string const& _name)
+namespace
+{
+
+struct Keyword
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
-#define KEYWORD(name, string, precedence) {string, Token::name},
+	string_view name;
+	Token token;
+};
+
+// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+// and keywords to be put inside the keywords variable.
+#define KEYWORD(name, string, precedence) Keyword{string, Token::name},
 #define TOKEN(name, string, precedence)
-	static map<string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+constexpr Keyword keywords[] = {TOKEN_LIST(TOKEN, KEYWORD)};
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+
+constexpr size_t keywordCount = sizeof(keywords) / sizeof(keywords[0]);
+/// Size of the keyword hash table, has to be a power of two.
+constexpr size_t keywordTableSize = 2048;
+
+constexpr uint32_t keywordHash(string_view _name, uint32_t _seed)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u ^ _seed;
+	for (char c: _name)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 16777619u;
+	}
+	return hash & (keywordTableSize - 1);
+}
+
+/// @returns the first seed for which keywordHash does not map two keywords to the same slot.
+constexpr uint32_t findKeywordSeed()
+{
+	for (uint32_t seed = 0; ; ++seed)
+	{
+		array<bool, keywordTableSize> used{};
+		bool collision = false;
+		for (size_t i = 0; i < keywordCount && !collision; ++i)
+		{
+			uint32_t slot = keywordHash(keywords[i].name, seed);
+			collision = used[slot];
+			used[slot] = true;
+		}
+		if (!collision)
+			return seed;
+	}
+}
+
+constexpr uint32_t keywordSeed = findKeywordSeed();
+
+/// Perfect hash table of the keywords, maps slots to one plus the index into keywords, zero if unused.
+static_assert(keywordCount < 256, "Keyword indices have to fit into the keyword table.");
+constexpr array<uint8_t, keywordTableSize> keywordTable = []() {
+	array<uint8_t, keywordTableSize> table{};
+	for (size_t i = 0; i < keywordCount; ++i)
+		table[keywordHash(keywords[i].name, keywordSeed)] = static_cast<uint8_t>(i + 1);
+	return table;
+}();
+
+Token keywordByName(string_view _name)
+{
+	uint8_t entry = keywordTable[keywordHash(_name, keywordSeed)];
+	if (entry && keywords[entry - 1].name == _name)
+		return keywords[entry - 1].token;
+	return Token::Identifier;
+}
+
 }
 
 bool isYulKeyword(string const& _literal)
@@ -133,11 +195,11 @@ bool isYulKeyword(string const& _literal)
 	return _literal == "leave" || isYulKeyword(keywordByName(_literal));
 }
 
-tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _literal)
+tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string_view _literal)
 {
 	// Used for `bytesM`, `uintM`, `intM`, `fixedMxN`, `ufixedMxN`.
 	// M/N must be shortest representation. M can never be 0. N can be zero.
-	auto parseSize = [](string::const_iterator _begin, string::const_iterator _end) -> int
+	auto parseSize = [](string_view::const_iterator _begin, string_view::const_iterator _end) -> int
 	{
 		// No number.
 		if (distance(_begin, _end) == 0)
@@ -164,7 +226,7 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
 	if (positionM != _literal.end())
 	{
-		string baseType(_literal.begin(), positionM);
+		string_view baseType = _literal.substr(0, static_cast<size_t>(positionM - _literal.begin()));
 		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
 		int m = parseSize(positionM, positionX);
 		Token keyword = keywordByName(baseType);
@@ -48,6 +48,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <tuple>
 
 namespace solidity::langutil
@@ -360,7 +361,7 @@ namespace TokenTraits
 		#undef T
 	}
 
-	std::tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(std::string const& _literal);
+	std::tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(std::string_view _literal);
 
 	// @returns a string corresponding to the C++ token name
 	// (e.g. "LT" for the token LT).
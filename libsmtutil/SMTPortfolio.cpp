@@ -26,19 +26,108 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 using namespace solidity::smtutil;
 
+/**
+ * The results of the solvers running in their own threads for a single query.
+ * Errors of the operations scheduled before the query are reported on it as well.
+ */
+struct SMTPortfolio::Query
+{
+	void recordError(exception_ptr _error)
+	{
+		lock_guard<std::mutex> lock(mutex);
+		if (!error)
+			error = move(_error);
+	}
+
+	std::mutex mutex;
+	condition_variable done;
+	vector<optional<pair<CheckResult, vector<string>>>> results;
+	/// Whether the solver with the same index is currently checking this query.
+	vector<bool> checking;
+	size_t pending = 0;
+	exception_ptr error;
+	/// Index of the first solver that answered, only used for the race strategy.
+	optional<size_t> winner;
+};
+
+/**
+ * Runs the operations scheduled for a solver in a dedicated thread,
+ * in the order they were scheduled. The operations must not throw.
+ */
+class SMTPortfolio::SolverThread
+{
+public:
+	explicit SolverThread(SolverInterface& _solver):
+		m_solver(_solver),
+		m_thread([this]() { run(); })
+	{}
+
+	~SolverThread()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopped = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	void schedule(function<void(SolverInterface&)> _operation)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_operations.emplace_back(move(_operation));
+		}
+		m_condition.notify_all();
+	}
+
+private:
+	void run()
+	{
+		while (true)
+		{
+			function<void(SolverInterface&)> operation;
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_condition.wait(lock, [&]() { return m_stopped || !m_operations.empty(); });
+				if (m_stopped)
+					return;
+				operation = move(m_operations.front());
+				m_operations.pop_front();
+			}
+			operation(m_solver);
+		}
+	}
+
+	SolverInterface& m_solver;
+	mutex m_mutex;
+	condition_variable m_condition;
+	deque<function<void(SolverInterface&)>> m_operations;
+	bool m_stopped = false;
+	/// Declared last so that everything else is initialized when the thread starts.
+	thread m_thread;
+};
+
 SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	SMTPortfolioStrategy _strategy
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_strategy(_strategy)
 {
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
 #ifdef HAVE_Z3
@@ -49,37 +138,43 @@ SMTPortfolio::SMTPortfolio(
 	if (_enabledSolvers.cvc4)
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
 #endif
+	// The SMTLib2 interface stays on the calling thread because of the callback.
+	if (m_strategy != SMTPortfolioStrategy::Sequential)
+	{
+		for (size_t i = 1; i < m_solvers.size(); ++i)
+			m_threads.emplace_back(make_unique<SolverThread>(*m_solvers[i]));
+		m_nextQuery = make_shared<Query>();
+	}
 }
 
+SMTPortfolio::~SMTPortfolio() = default;
+
 void SMTPortfolio::reset()
 {
-	for (auto const& s: m_solvers)
-		s->reset();
+	forEachSolver([](SolverInterface& _solver) { _solver.reset(); });
 }
 
 void SMTPortfolio::push()
 {
-	for (auto const& s: m_solvers)
-		s->push();
+	forEachSolver([](SolverInterface& _solver) { _solver.push(); });
 }
 
 void SMTPortfolio::pop()
 {
-	for (auto const& s: m_solvers)
-		s->pop();
+	forEachSolver([](SolverInterface& _solver) { _solver.pop(); });
 }
 
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
-	for (auto const& s: m_solvers)
-		s->declareVariable(_name, _sort);
+	forEachSolver([=](SolverInterface& _solver) { _solver.declareVariable(_name, _sort); });
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
-	for (auto const& s: m_solvers)
-		s->addAssertion(_expr);
+	// Share a single copy of the expression between the threads.
+	auto expr = make_shared<Expression const>(_expr);
+	forEachSolver([expr](SolverInterface& _solver) { _solver.addAssertion(*expr); });
 }
 
 /*
@@ -111,16 +206,141 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * With the race strategy, the first SAT/UNSAT answer is returned without waiting for
+ * the other solvers, so a conflict is not detected. The solvers that are still checking
+ * the query are interrupted, and solvers that fell behind skip the queries that were
+ * already answered once they catch up. The SMTLib2 interface runs on the calling thread
+ * and cannot be interrupted, so its answer is always awaited.
+ *
+ * If a solver running in its own thread fails on one of the operations before a query
+ * or on the query itself, the exception is rethrown by the check of that query, unless
+ * the query was already answered with the race strategy.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	if (!m_threads.empty())
+		return checkConcurrently(_expressionsToEvaluate);
+
+	vector<pair<CheckResult, vector<string>>> results;
+	for (auto const& s: m_solvers)
+		results.emplace_back(s->check(_expressionsToEvaluate));
+	return combine(move(results));
+}
+
+vector<string> SMTPortfolio::unhandledQueries()
+{
+	// This code assumes that the constructor guarantees that
+	// SmtLib2Interface is in position 0.
+	smtAssert(!m_solvers.empty(), "");
+	smtAssert(dynamic_cast<SMTLib2Interface*>(m_solvers.front().get()), "");
+	return m_solvers.front()->unhandledQueries();
+}
+
+void SMTPortfolio::forEachSolver(function<void(SolverInterface&)> _operation)
+{
+	_operation(*m_solvers.front());
+	if (m_threads.empty())
+		for (size_t i = 1; i < m_solvers.size(); ++i)
+			_operation(*m_solvers[i]);
+	else
+		for (auto const& thread: m_threads)
+			thread->schedule([_operation, query = m_nextQuery](SolverInterface& _solver) {
+				try
+				{
+					_operation(_solver);
+				}
+				catch (...)
+				{
+					query->recordError(current_exception());
+				}
+			});
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkConcurrently(vector<Expression> const& _expressionsToEvaluate)
+{
+	// The operations scheduled from now on belong to the next query.
+	shared_ptr<Query> query = exchange(m_nextQuery, make_shared<Query>());
+	query->results.resize(m_solvers.size());
+	query->checking.resize(m_solvers.size(), false);
+	query->pending = m_threads.size();
+	auto expressions = make_shared<vector<Expression> const>(_expressionsToEvaluate);
+	bool const race = m_strategy == SMTPortfolioStrategy::Race;
+
+	// Has to be called with the mutex of the query locked.
+	auto recordResult = [this, query, race](size_t _index, pair<CheckResult, vector<string>> _result)
+	{
+		if (race && !query->winner && solverAnswered(_result.first))
+		{
+			query->winner = _index;
+			// The other results are not needed anymore. The mutex ensures that the
+			// interrupted solvers are still checking this query and not a later one.
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (query->checking[i])
+					m_solvers[i]->interrupt();
+		}
+		query->results[_index] = move(_result);
+	};
+
+	for (size_t i = 0; i < m_threads.size(); ++i)
+		m_threads[i]->schedule([=](SolverInterface& _solver) {
+			{
+				// Solvers that fell behind do not have to answer queries that are already decided,
+				// and the query fails anyway if an operation before it failed.
+				lock_guard<std::mutex> lock(query->mutex);
+				if (query->winner)
+					return;
+				if (query->error)
+				{
+					--query->pending;
+					query->done.notify_all();
+					return;
+				}
+				query->checking[i + 1] = true;
+			}
+			optional<pair<CheckResult, vector<string>>> result;
+			try
+			{
+				result = _solver.check(*expressions);
+			}
+			catch (...)
+			{
+				query->recordError(current_exception());
+			}
+			{
+				lock_guard<std::mutex> lock(query->mutex);
+				query->checking[i + 1] = false;
+				if (result)
+					recordResult(i + 1, move(*result));
+				--query->pending;
+			}
+			query->done.notify_all();
+		});
+
+	auto result = m_solvers.front()->check(_expressionsToEvaluate);
+
+	unique_lock<std::mutex> lock(query->mutex);
+	recordResult(0, move(result));
+	query->done.wait(lock, [&]() { return query->winner || query->pending == 0; });
+	if (query->error && !query->winner)
+		rethrow_exception(query->error);
+
+	if (query->winner)
+		return *query->results[*query->winner];
+
+	vector<pair<CheckResult, vector<string>>> results;
+	for (auto& result: query->results)
+		if (result)
+			results.emplace_back(move(*result));
+	return combine(move(results));
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::combine(vector<pair<CheckResult, vector<string>>> _results)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& [result, values]: _results)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -140,15 +360,6 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
-vector<string> SMTPortfolio::unhandledQueries()
-{
-	// This code assumes that the constructor guarantees that
-	// SmtLib2Interface is in position 0.
-	smtAssert(!m_solvers.empty(), "");
-	smtAssert(dynamic_cast<SMTLib2Interface*>(m_solvers.front().get()), "");
-	return m_solvers.front()->unhandledQueries();
-}
-
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
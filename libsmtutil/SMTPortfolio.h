@@ -24,7 +24,9 @@
 #include <libsolutil/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
+#include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -35,6 +37,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Unless the strategy is sequential, the solvers run in their own threads
+ * and only the SMTLib2 interface is queried from the calling thread.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
@@ -43,8 +47,10 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		SMTPortfolioStrategy _strategy = SMTPortfolioStrategy::Sequential
 	);
+	~SMTPortfolio() override;
 
 	void reset() override;
 
@@ -60,9 +66,26 @@ public:
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
 private:
+	struct Query;
+	class SolverThread;
+
+	/// Calls @a _operation on all solvers, on their threads if there are any.
+	/// Errors on the threads are reported by the next call to check().
+	void forEachSolver(std::function<void(SolverInterface&)> _operation);
+	std::pair<CheckResult, std::vector<std::string>> checkConcurrently(std::vector<Expression> const& _expressionsToEvaluate);
+	/// Combines the results of the individual solvers as described at check().
+	static std::pair<CheckResult, std::vector<std::string>> combine(
+		std::vector<std::pair<CheckResult, std::vector<std::string>>> _results
+	);
 	static bool solverAnswered(CheckResult result);
 
+	SMTPortfolioStrategy m_strategy;
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// Threads for all solvers but the first one, empty for the sequential strategy.
+	/// Declared after the solvers since they have to be destroyed first.
+	std::vector<std::unique_ptr<SolverThread>> m_threads;
+	/// The query the operations scheduled on the threads belong to, i.e. the next one.
+	std::shared_ptr<Query> m_nextQuery;
 
 	std::vector<Expression> m_assertions;
 };
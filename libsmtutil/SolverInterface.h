@@ -49,6 +49,17 @@ struct SMTSolverChoice
 	bool all() { return cvc4 && z3; }
 };
 
+/// How a portfolio of solvers answers a query.
+enum class SMTPortfolioStrategy
+{
+	/// Query the solvers one after the other and cross-check their answers.
+	Sequential,
+	/// Query the solvers concurrently and cross-check their answers.
+	Parallel,
+	/// Query the solvers concurrently and use the first SAT or UNSAT answer.
+	Race
+};
+
 enum class CheckResult
 {
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
@@ -400,6 +411,10 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that is running on another thread to return as soon as possible,
+	/// without an answer. Has no effect if no check is running. Can be called from any thread.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
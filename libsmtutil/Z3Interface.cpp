@@ -139,6 +139,13 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	// Unlike z3::context::interrupt(), this only affects a running check
+	// and does not cancel the next operation if the solver is idle.
+	Z3_solver_interrupt(m_context, m_solver);
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
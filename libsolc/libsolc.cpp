@@ -30,7 +30,10 @@
 
 #include <cstdlib>
 #include <list>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <vector>
 
 #include "license.h"
 
@@ -114,6 +117,44 @@ string compile(string _input, CStyleReadFileCallback _readCallback, void* _readC
 	return compiler.compile(move(_input));
 }
 
+/// Stream buffer that passes its contents to a write callback whenever it is full or flushed.
+class WriteCallbackBuffer: public streambuf
+{
+public:
+	WriteCallbackBuffer(CStyleWriteOutputCallback _writeCallback, void* _writeContext):
+		m_writeCallback(_writeCallback),
+		m_writeContext(_writeContext),
+		m_buffer(64 * 1024)
+	{
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+	}
+
+protected:
+	int_type overflow(int_type _character) override
+	{
+		sync();
+		if (!traits_type::eq_int_type(_character, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(_character);
+			pbump(1);
+		}
+		return traits_type::not_eof(_character);
+	}
+
+	int sync() override
+	{
+		if (pptr() != pbase())
+			m_writeCallback(m_writeContext, pbase(), static_cast<size_t>(pptr() - pbase()));
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+		return 0;
+	}
+
+private:
+	CStyleWriteOutputCallback m_writeCallback;
+	void* m_writeContext;
+	vector<char> m_buffer;
+};
+
 }
 
 extern "C"
@@ -134,6 +175,21 @@ extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCa
 	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
 }
 
+extern void solidity_compile_streaming(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleWriteOutputCallback _writeCallback,
+	void* _writeContext
+) noexcept
+{
+	WriteCallbackBuffer buffer(_writeCallback, _writeContext);
+	ostream output(&buffer);
+	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.compile(_input, output);
+	output.flush();
+}
+
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
@@ -52,6 +52,13 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Callback used to receive the output of solidity_compile_streaming piece by piece.
+///
+/// @param _context The writeContext passed to solidity_compile_streaming. Can be NULL.
+/// @param _data The next part of the output. It is not zero-terminated and only valid during the call.
+/// @param _length The length of the part in bytes.
+typedef void (*CStyleWriteOutputCallback)(void* _context, char const* _data, size_t _length);
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -90,6 +97,26 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Takes a "Standard Input JSON" and an optional read callback like solidity_compile, but
+/// passes the "Standard Output JSON" to @p _writeCallback while it is produced instead of
+/// returning it. The output of each contract is passed on as soon as it has been computed,
+/// so the output of all contracts is never held in memory at the same time. Concatenating
+/// all parts results in the same output as solidity_compile, except that an internal error
+/// while computing the output of a contract is reported as an error and the contract is left out.
+///
+/// @param _input The input JSON to process.
+/// @param _readCallback The optional callback pointer. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+/// @param _writeCallback The callback that receives the output. Must not be NULL.
+/// @param _writeContext An optional context pointer passed to _writeCallback. Can be NULL.
+void solidity_compile_streaming(
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleWriteOutputCallback _writeCallback,
+	void* _writeContext
+) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
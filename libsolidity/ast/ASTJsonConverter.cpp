@@ -65,6 +65,28 @@ void addIfSet(std::vector<pair<string, Json::Value>>& _attributes, string const&
 	_attributes.emplace_back(_name, *_value);
 }
 
+/// Member name of the placeholders for AST nodes.
+string const placeholderNodeKey = "@node";
+
+/// Compact json writer that replaces the placeholders of AST nodes.
+class PlaceholderExpandingWriter: public solidity::util::CompactJsonWriter
+{
+public:
+	PlaceholderExpandingWriter(ostream& _stream, solidity::frontend::ASTJsonConverter& _converter):
+		CompactJsonWriter(_stream),
+		m_converter(_converter)
+	{}
+
+protected:
+	optional<Json::Value> expand(Json::Value const& _object) override
+	{
+		return m_converter.expandPlaceholder(_object);
+	}
+
+private:
+	solidity::frontend::ASTJsonConverter& m_converter;
+};
+
 }
 
 namespace solidity::frontend
@@ -131,11 +153,14 @@ string ASTJsonConverter::namePathToString(std::vector<ASTString> const& _namePat
 
 Json::Value ASTJsonConverter::typePointerToJson(Type const* _tp, bool _short)
 {
-	Json::Value typeDescriptions(Json::objectValue);
-	typeDescriptions["typeString"] = _tp ? Json::Value(_tp->toString(_short)) : Json::nullValue;
-	typeDescriptions["typeIdentifier"] = _tp ? Json::Value(_tp->identifier()) : Json::nullValue;
+	auto [it, inserted] = m_typeDescriptions.try_emplace({_tp, _short}, Json::objectValue);
+	Json::Value& typeDescriptions = it->second;
+	if (inserted)
+	{
+		typeDescriptions["typeString"] = _tp ? Json::Value(_tp->toString(_short)) : Json::nullValue;
+		typeDescriptions["typeIdentifier"] = _tp ? Json::Value(_tp->identifier()) : Json::nullValue;
+	}
 	return typeDescriptions;
-
 }
 Json::Value ASTJsonConverter::typePointerToJson(std::optional<FuncCallArguments> const& _tps)
 {
@@ -188,8 +213,63 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 	_stream << util::jsonPrettyPrint(toJson(_node));
 }
 
+void ASTJsonConverter::printCompact(ostream& _stream, ASTNode const& _node)
+{
+	printCompact(_stream, placeholder(_node));
+}
+
+void ASTJsonConverter::printCompact(ostream& _stream, Json::Value const& _json)
+{
+	PlaceholderExpandingWriter(_stream, *this).write(_json);
+}
+
+Json::Value ASTJsonConverter::placeholder(ASTNode const& _node)
+{
+	return nodePlaceholder(_node, false);
+}
+
+optional<Json::Value> ASTJsonConverter::expandPlaceholder(Json::Value const& _json)
+{
+	// Source names are used as member names in the output, so only an object with exactly
+	// this member that refers to a node that has not been expanded yet is a placeholder.
+	Json::Value const* index = _json.find(placeholderNodeKey.data(), placeholderNodeKey.data() + placeholderNodeKey.size());
+	if (
+		!index ||
+		!index->isUInt64() ||
+		_json.size() != 1 ||
+		index->asUInt64() >= m_pendingNodes.size() ||
+		!m_pendingNodes[index->asUInt64()].first
+	)
+		return nullopt;
+
+	solAssert(!m_createPlaceholders, "");
+	bool const inEvent = m_inEvent;
+	m_createPlaceholders = true;
+	ScopeGuard resetState([&]() {
+		m_createPlaceholders = false;
+		m_inEvent = inEvent;
+	});
+
+	// The children of the node are converted when their placeholders are expanded,
+	// so the state of the converter has to be the same as when they were reached.
+	ASTNode const* node = nullptr;
+	tie(node, m_inEvent) = exchange(m_pendingNodes[index->asUInt64()], {nullptr, false});
+	node->accept(*this);
+	return util::removeNullMembers(std::move(m_currentValue));
+}
+
+Json::Value ASTJsonConverter::nodePlaceholder(ASTNode const& _node, bool _inEvent)
+{
+	Json::Value placeholder{Json::objectValue};
+	placeholder[placeholderNodeKey] = Json::UInt64(m_pendingNodes.size());
+	m_pendingNodes.emplace_back(&_node, _inEvent);
+	return placeholder;
+}
+
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
+	if (m_createPlaceholders)
+		return nodePlaceholder(_node, m_inEvent);
 	_node.accept(*this);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
@@ -59,6 +59,19 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Writes the json representation of the AST to _stream in the format of util::jsonCompactPrint.
+	/// The AST is converted and written node by node, so the json tree of the whole AST
+	/// is never built.
+	void printCompact(std::ostream& _stream, ASTNode const& _node);
+	/// Writes _json to _stream like util::jsonCompactPrint, but replaces the values
+	/// created by placeholder() by the json representation of their AST.
+	void printCompact(std::ostream& _stream, Json::Value const& _json);
+	/// @returns a value that stands for the json representation of the AST _node.
+	/// It can only be expanded by this converter, and only once.
+	Json::Value placeholder(ASTNode const& _node);
+	/// @returns the json representation of the node of a value created by placeholder(),
+	/// with placeholders for its children, or nullopt if _json is not a placeholder.
+	std::optional<Json::Value> expandPlaceholder(Json::Value const& _json);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -179,12 +192,14 @@ private:
 
 		return json;
 	}
-	static Json::Value typePointerToJson(Type const* _tp, bool _short = false);
-	static Json::Value typePointerToJson(std::optional<FuncCallArguments> const& _tps);
+	Json::Value typePointerToJson(Type const* _tp, bool _short = false);
+	Json::Value typePointerToJson(std::optional<FuncCallArguments> const& _tps);
 	void appendExpressionAttributes(
 		std::vector<std::pair<std::string, Json::Value>> &_attributes,
 		ExpressionAnnotation const& _annotation
 	);
+	/// @returns a placeholder for _node, which refers to its entry in m_pendingNodes.
+	Json::Value nodePlaceholder(ASTNode const& _node, bool _inEvent);
 	static void appendMove(Json::Value& _array, Json::Value&& _value)
 	{
 		solAssert(_array.isArray(), "");
@@ -193,7 +208,15 @@ private:
 
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	/// If true, toJson returns placeholders for the nodes, which are expanded later.
+	bool m_createPlaceholders = false;
+	/// The nodes of the placeholders, by the index stored in the placeholder, and whether
+	/// they are inside an event. Reset to null once the placeholder is expanded.
+	std::vector<std::pair<ASTNode const*, bool>> m_pendingNodes;
 	Json::Value m_currentValue;
+	/// Type descriptions by type and whether the short type string is used.
+	/// Computing the type strings is expensive and most types occur many times.
+	std::map<std::pair<Type const*, bool>, Json::Value> m_typeDescriptions;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
@@ -192,6 +192,8 @@ void TypeProvider::reset()
 	clearCaches(instance().m_magics);
 
 	instance().m_generalTypes.clear();
+	instance().m_cachedTypes = {};
+	instance().m_statistics = {};
 	instance().m_stringLiteralTypes.clear();
 	instance().m_ufixedMxN.clear();
 	instance().m_fixedMxN.clear();
@@ -201,9 +203,24 @@ template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
 	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
+	++instance().m_statistics.createdTypes;
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename Key, typename... Args>
+inline T const* TypeProvider::createAndGetCached(map<Key, Type const*>& _cache, Key _key, Args&& ... _args)
+{
+	auto it = _cache.find(_key);
+	if (it != _cache.end())
+	{
+		++instance().m_statistics.reusedTypes;
+		return static_cast<T const*>(it->second);
+	}
+	T const* type = createAndGet<T>(std::forward<Args>(_args)...);
+	_cache.emplace(move(_key), type);
+	return type;
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -404,7 +421,7 @@ TupleType const* TypeProvider::tuple(vector<Type const*> members)
 	if (members.empty())
 		return &m_emptyTuple;
 
-	return createAndGet<TupleType>(move(members));
+	return createAndGetCached<TupleType>(instance().m_cachedTypes.tuples, members, members);
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,23 +429,40 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
+	auto& cache = instance().m_cachedTypes.locationCopies;
+	auto key = make_tuple(_type, _location, _isPointer);
+	auto it = cache.find(key);
+	if (it != cache.end())
+	{
+		++instance().m_statistics.reusedTypes;
+		return static_cast<ReferenceType const*>(it->second);
+	}
+
 	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	++instance().m_statistics.createdTypes;
+	Type const* copy = instance().m_generalTypes.back().get();
+	cache.emplace(key, copy);
+	return static_cast<ReferenceType const*>(copy);
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
 {
-	return createAndGet<FunctionType>(_function, _kind);
+	return createAndGetCached<FunctionType>(
+		instance().m_cachedTypes.functions,
+		make_pair(&_function, _kind),
+		_function,
+		_kind
+	);
 }
 
 FunctionType const* TypeProvider::function(VariableDeclaration const& _varDecl)
 {
-	return createAndGet<FunctionType>(_varDecl);
+	return createAndGetCached<FunctionType>(instance().m_cachedTypes.getters, &_varDecl, _varDecl);
 }
 
 FunctionType const* TypeProvider::function(EventDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return createAndGetCached<FunctionType>(instance().m_cachedTypes.events, &_def, _def);
 }
 
 FunctionType const* TypeProvider::function(FunctionTypeName const& _typeName)
@@ -483,7 +517,12 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	return createAndGetCached<RationalNumberType>(
+		instance().m_cachedTypes.rationalNumbers,
+		make_pair(_value, _compatibleBytesType),
+		_value,
+		_compatibleBytesType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -502,47 +541,73 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createAndGetCached<ArrayType>(
+		instance().m_cachedTypes.bytesArrays,
+		make_pair(_location, _isString),
+		_location,
+		_isString
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createAndGetCached<ArrayType>(
+		instance().m_cachedTypes.dynamicArrays,
+		make_pair(_location, _baseType),
+		_location,
+		_baseType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createAndGetCached<ArrayType>(
+		instance().m_cachedTypes.staticArrays,
+		make_tuple(_location, _baseType, _length),
+		_location,
+		_baseType,
+		_length
+	);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return createAndGetCached<ArraySliceType>(instance().m_cachedTypes.arraySlices, &_arrayType, _arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return createAndGetCached<ContractType>(
+		instance().m_cachedTypes.contracts,
+		make_pair(&_contractDef, _isSuper),
+		_contractDef,
+		_isSuper
+	);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
 {
-	return createAndGet<EnumType>(_enumDef);
+	return createAndGetCached<EnumType>(instance().m_cachedTypes.enums, &_enumDef, _enumDef);
 }
 
 ModuleType const* TypeProvider::module(SourceUnit const& _source)
 {
-	return createAndGet<ModuleType>(_source);
+	return createAndGetCached<ModuleType>(instance().m_cachedTypes.modules, &_source, _source);
 }
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return createAndGetCached<TypeType>(instance().m_cachedTypes.typeTypes, _actualType, _actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return createAndGetCached<StructType>(
+		instance().m_cachedTypes.structs,
+		make_pair(&_struct, _location),
+		_struct,
+		_location
+	);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
@@ -565,10 +630,15 @@ MagicType const* TypeProvider::meta(Type const* _type)
 		),
 		"Only contracts or integer types supported for now."
 	);
-	return createAndGet<MagicType>(_type);
+	return createAndGetCached<MagicType>(instance().m_cachedTypes.metaTypes, _type, _type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valueType)
 {
-	return createAndGet<MappingType>(_keyType, _valueType);
+	return createAndGetCached<MappingType>(
+		instance().m_cachedTypes.mappings,
+		make_pair(_keyType, _valueType),
+		_keyType,
+		_valueType
+	);
 }
@@ -24,7 +24,9 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -52,6 +54,16 @@ public:
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
+	/// Counters about the dynamically created types since the last reset.
+	struct Statistics
+	{
+		/// Number of types that were allocated.
+		size_t createdTypes = 0;
+		/// Number of requests that were answered with an already existing identical type.
+		size_t reusedTypes = 0;
+	};
+	static Statistics const& statistics() { return instance().m_statistics; }
+
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
 	static Type const* fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability = {});
@@ -210,6 +222,11 @@ private:
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
+	/// Looks up @a _key in @a _cache and only creates the type from @a _args if it is not found.
+	/// Can only be used for types that are fully determined by the key.
+	template <typename T, typename Key, typename... Args>
+	static inline T const* createAndGetCached(std::map<Key, Type const*>& _cache, Key _key, Args&& ... _args);
+
 	static BoolType const m_boolean;
 	static InaccessibleDynamicType const m_inaccessibleDynamic;
 
@@ -232,6 +249,31 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// Types that are fully determined by the arguments they are created from, so that an
+	/// identical type is only created once. The types themselves are owned by m_generalTypes.
+	struct CachedTypes
+	{
+		std::map<std::pair<DataLocation, bool>, Type const*> bytesArrays;
+		std::map<std::pair<DataLocation, Type const*>, Type const*> dynamicArrays;
+		std::map<std::tuple<DataLocation, Type const*, u256>, Type const*> staticArrays;
+		std::map<ArrayType const*, Type const*> arraySlices;
+		std::map<std::pair<ContractDefinition const*, bool>, Type const*> contracts;
+		std::map<EnumDefinition const*, Type const*> enums;
+		std::map<SourceUnit const*, Type const*> modules;
+		std::map<Type const*, Type const*> typeTypes;
+		std::map<std::pair<StructDefinition const*, DataLocation>, Type const*> structs;
+		std::map<Type const*, Type const*> metaTypes;
+		std::map<std::pair<Type const*, Type const*>, Type const*> mappings;
+		std::map<std::vector<Type const*>, Type const*> tuples;
+		std::map<std::tuple<ReferenceType const*, DataLocation, bool>, Type const*> locationCopies;
+		std::map<std::pair<rational, Type const*>, Type const*> rationalNumbers;
+		std::map<std::pair<FunctionDefinition const*, FunctionType::Kind>, Type const*> functions;
+		std::map<VariableDeclaration const*, Type const*> getters;
+		std::map<EventDefinition const*, Type const*> events;
+	};
+	CachedTypes m_cachedTypes{};
+	Statistics m_statistics{};
 };
 
 }
@@ -50,8 +50,10 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
-#include <utility>
+#include <mutex>
 #include <numeric>
+#include <tuple>
+#include <utility>
 
 // Change to "define" to output all intermediate code
 #undef SOL_OUTPUT_ASM
@@ -64,6 +66,84 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Parsed and analyzed snippet of inline assembly generated by the code generator.
+struct ParsedInlineAssembly
+{
+	shared_ptr<yul::Block const> code;
+	shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+};
+
+/// Cache of the inline assembly snippets generated by the code generator. The same snippets
+/// are requested over and over again during code generation, only the source location
+/// they are attributed to differs, and that is applied during code generation.
+/// Optimized snippets are stored after optimization.
+class InlineAssemblyCache
+{
+public:
+	/// Everything the parsed, analyzed and optimized code depends on.
+	struct Key
+	{
+		string code;
+		vector<string> localVariables;
+		EVMVersion evmVersion;
+		/// Only set for optimized snippets: the functions used from outside, whether the
+		/// snippet is part of the creation code, whether the stack allocation is optimized,
+		/// the optimizer steps, the expected number of executions and whether functions
+		/// are optimized separately.
+		optional<tuple<set<string>, bool, bool, string, size_t, bool>> optimization;
+
+		bool operator<(Key const& _other) const
+		{
+			return
+				tie(code, localVariables, evmVersion, optimization) <
+				tie(_other.code, _other.localVariables, _other.evmVersion, _other.optimization);
+		}
+	};
+
+	static InlineAssemblyCache& instance()
+	{
+		static InlineAssemblyCache cache;
+		return cache;
+	}
+
+	optional<ParsedInlineAssembly> find(Key const& _key)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (auto it = m_entries.find(_key); it != m_entries.end())
+			return it->second;
+		return nullopt;
+	}
+
+	void insert(Key _key, ParsedInlineAssembly _snippet)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		// Snippets can contain literals specific to a contract, so bound the size.
+		if (m_entries.size() >= maxEntries)
+			m_entries.clear();
+		m_entries.emplace(move(_key), move(_snippet));
+	}
+
+private:
+	static size_t constexpr maxEntries = 4096;
+
+	InlineAssemblyCache():
+		m_resetCallback([this]() {
+			// The cached ASTs refer to YulStrings.
+			lock_guard<mutex> lock(m_mutex);
+			m_entries.clear();
+		})
+	{}
+
+	mutex m_mutex;
+	map<Key, ParsedInlineAssembly> m_entries;
+	yul::YulStringRepository::ResetCallback m_resetCallback;
+};
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -400,6 +480,16 @@ void CompilerContext::appendInlineAssembly(
 	for (auto const& var: _localVariables)
 		externallyUsedIdentifiers.insert(yul::YulString(var));
 
+	// Snippets are cached, so they are not attributed to the current source location while
+	// parsing. Instead, the location is applied to all generated items.
+	optional<langutil::SourceLocation> parserLocationOverride;
+	optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+	{
+		parserLocationOverride = langutil::SourceLocation{};
+		locationOverride = m_asm->currentSourceLocation();
+	}
+
 	yul::ExternalIdentifierAccess identifierAccess;
 	identifierAccess.resolve = [&](
 		yul::Identifier const& _identifier,
@@ -426,7 +516,7 @@ void CompilerContext::appendInlineAssembly(
 		if (stackDiff < 1 || stackDiff > 16)
 			BOOST_THROW_EXCEPTION(
 				StackTooDeepError() <<
-				errinfo_sourceLocation(_identifier.location) <<
+				errinfo_sourceLocation(locationOverride ? *locationOverride : _identifier.location) <<
 				util::errinfo_comment("Stack too deep (" + to_string(stackDiff) + "), try removing local variables.")
 			);
 		if (_context == yul::IdentifierContext::RValue)
@@ -440,17 +530,32 @@ void CompilerContext::appendInlineAssembly(
 
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
-	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
-		.parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
+
+	// Several optimizer steps cannot handle externally supplied stack variables,
+	// so we essentially only optimize the ABI functions.
+	bool const runOptimiser = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	// The utility code is stored as generated source and only requested once per contract.
+	bool const cacheable = !_system;
+	InlineAssemblyCache::Key cacheKey{_assembly, _localVariables, m_evmVersion, nullopt};
+	if (runOptimiser)
+		cacheKey.optimization = make_tuple(
+			_externallyUsedFunctions,
+			runtimeContext() != nullptr,
+			_optimiserSettings.optimizeStackAllocation,
+			_optimiserSettings.yulOptimiserSteps,
+			_optimiserSettings.expectedExecutionsPerDeployment,
+			_optimiserSettings.optimizeYulFunctionsSeparately
+		);
+
+	shared_ptr<yul::Block const> parserResult;
+	shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+	if (cacheable)
+		if (auto cached = InlineAssemblyCache::instance().find(cacheKey))
+		{
+			parserResult = move(cached->code);
+			analysisInfo = move(cached->analysisInfo);
+		}
 
 	auto reportError = [&](string const& _context)
 	{
@@ -467,66 +572,79 @@ void CompilerContext::appendInlineAssembly(
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	if (!parserResult)
 	{
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
+		shared_ptr<yul::Block> parsed =
+			yul::Parser(errorReporter, dialect, parserLocationOverride)
+			.parse(scanner, false);
+#ifdef SOL_OUTPUT_ASM
+		cout << yul::AsmPrinter(&dialect)(*parsed) << endl;
+#endif
+
+		analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+		bool analyzerResult = false;
+		if (parsed)
+			analyzerResult = yul::AsmAnalyzer(
+				*analysisInfo,
+				errorReporter,
+				dialect,
+				identifierAccess.resolve
+			).analyze(*parsed);
+		if (!parsed || !errorReporter.errors().empty() || !analyzerResult)
+			reportError("Invalid assembly generated by code generator.");
+
+		if (runOptimiser)
+		{
+			yul::Object obj;
+			obj.code = parsed;
+			obj.analysisInfo = analysisInfo;
+
+			optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+
+			if (_system)
+			{
+				// Store as generated sources, but first re-parse to update the source references.
+				solAssert(m_generatedYulUtilityCode.empty(), "");
+				m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
+				scanner = make_shared<langutil::Scanner>(langutil::CharStream(m_generatedYulUtilityCode, _sourceName));
+				obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
+				*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			}
 
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+			analysisInfo = move(obj.analysisInfo);
+			parsed = move(obj.code);
 
-		if (_system)
+#ifdef SOL_OUTPUT_ASM
+			cout << "After optimizer:" << endl;
+			cout << yul::AsmPrinter(&dialect)(*parsed) << endl;
+#endif
+		}
+		else if (_system)
 		{
-			// Store as generated sources, but first re-parse to update the source references.
+			// Store as generated source.
 			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
-			string code = yul::AsmPrinter{dialect}(*obj.code);
-			scanner = make_shared<langutil::Scanner>(langutil::CharStream(m_generatedYulUtilityCode, _sourceName));
-			obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
-			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+			m_generatedYulUtilityCode = _assembly;
 		}
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
+		if (!errorReporter.errors().empty())
+			reportError("Failed to analyze inline assembly block.");
 
-#ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
+		parserResult = move(parsed);
+		if (cacheable)
+			InlineAssemblyCache::instance().insert(move(cacheKey), {parserResult, analysisInfo});
 	}
-	else if (_system)
-	{
-		// Store as generated source.
-		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
-	}
-
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
 	yul::CodeGenerator::assemble(
 		*parserResult,
-		analysisInfo,
+		*analysisInfo,
 		*m_asm,
 		m_evmVersion,
 		identifierAccess,
 		_system,
-		_optimiserSettings.optimizeStackAllocation
+		_optimiserSettings.optimizeStackAllocation,
+		locationOverride
 	);
 
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
@@ -548,7 +666,9 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 		_object,
 		_optimiserSettings.optimizeStackAllocation,
 		_optimiserSettings.yulOptimiserSteps,
-		_externalIdentifiers
+		_externalIdentifiers,
+		_optimiserSettings.optimizeYulFunctionsSeparately,
+		_optimiserSettings.concurrent
 	);
 
 #ifdef SOL_OUTPUT_ASM
@@ -570,7 +690,7 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0, false};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
@@ -580,6 +700,7 @@ evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
+	asmSettings.concurrent = _settings.concurrent;
 	return asmSettings;
 }
 
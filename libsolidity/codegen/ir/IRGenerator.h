@@ -29,7 +29,14 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <memory>
 #include <string>
+#include <tuple>
+
+namespace solidity::yul
+{
+struct Object;
+}
 
 namespace solidity::frontend
 {
@@ -52,7 +59,8 @@ public:
 
 	/// Generates and returns the IR code, in unoptimized and optimized form
 	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// The third component is the analyzed Yul object the optimized form was printed from.
+	std::tuple<std::string, std::string, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
@@ -53,3 +53,15 @@ std::optional<ModelCheckerTargets> ModelCheckerTargets::fromString(string const&
 
 	return ModelCheckerTargets{chosenTargets};
 }
+
+std::optional<smtutil::SMTPortfolioStrategy> ModelCheckerSettings::solverStrategyFromString(string const& _strategy)
+{
+	static map<string, smtutil::SMTPortfolioStrategy> const strategyStrings{
+		{"sequential", smtutil::SMTPortfolioStrategy::Sequential},
+		{"parallel", smtutil::SMTPortfolioStrategy::Parallel},
+		{"race", smtutil::SMTPortfolioStrategy::Race}
+	};
+	if (strategyStrings.count(_strategy))
+		return strategyStrings.at(_strategy);
+	return {};
+}
@@ -72,6 +72,10 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::All();
 	std::optional<unsigned> timeout;
+	/// How BMC combines the answers of the available solvers.
+	smtutil::SMTPortfolioStrategy solverStrategy = smtutil::SMTPortfolioStrategy::Sequential;
+
+	static std::optional<smtutil::SMTPortfolioStrategy> solverStrategyFromString(std::string const& _strategy);
 };
 
 }
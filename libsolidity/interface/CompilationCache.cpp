@@ -0,0 +1,214 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <random>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Version of the format of the entries, has to be changed together with the format.
+int const entryFormatVersion = 1;
+
+Json::Value linkerObjectToJson(LinkerObject const& _object)
+{
+	Json::Value json{Json::objectValue};
+	json["bytecode"] = toHex(_object.bytecode);
+	json["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		json["linkReferences"][to_string(offset)] = library;
+	json["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value& immutable = json["immutableReferences"][hash.str()];
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+	}
+	return json;
+}
+
+optional<LinkerObject> linkerObjectFromJson(Json::Value const& _json)
+{
+	if (
+		!_json["bytecode"].isString() ||
+		!_json["linkReferences"].isObject() ||
+		!_json["immutableReferences"].isObject()
+	)
+		return nullopt;
+
+	LinkerObject object;
+	string const& bytecode = _json["bytecode"].asString();
+	object.bytecode = fromHex(bytecode);
+	if (object.bytecode.size() * 2 != bytecode.size())
+		return nullopt;
+	for (string const& offset: _json["linkReferences"].getMemberNames())
+	{
+		if (!_json["linkReferences"][offset].isString())
+			return nullopt;
+		object.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+	}
+	for (string const& hash: _json["immutableReferences"].getMemberNames())
+	{
+		Json::Value const& immutable = _json["immutableReferences"][hash];
+		if (!immutable["name"].isString() || !immutable["offsets"].isArray())
+			return nullopt;
+		auto& reference = object.immutableReferences[u256(hash)];
+		reference.first = immutable["name"].asString();
+		for (Json::Value const& offset: immutable["offsets"])
+		{
+			if (!offset.isUInt64())
+				return nullopt;
+			reference.second.push_back(static_cast<size_t>(offset.asUInt64()));
+		}
+	}
+	return object;
+}
+
+}
+
+CompilationCache::CompilationCache(fs::path _directory):
+	m_directory(move(_directory))
+{
+}
+
+optional<CompilationCache::Entry> CompilationCache::find(h256 const& _key)
+{
+	auto parseEntry = [&]() -> optional<Entry>
+	{
+		fs::path path = entryPath(_key);
+		boost::system::error_code error;
+		if (!fs::is_regular_file(path, error))
+			return nullopt;
+
+		Json::Value json;
+		if (!jsonParseStrict(readFileAsString(path.string()), json) || !json.isObject())
+			return nullopt;
+		if (
+			json["version"] != entryFormatVersion ||
+			json["key"] != _key.hex() ||
+			!json["sourceMapping"].isString() ||
+			!json["runtimeSourceMapping"].isString() ||
+			!json["generatedSources"].isArray() ||
+			!json["runtimeGeneratedSources"].isArray()
+		)
+			return nullopt;
+
+		optional<LinkerObject> object = linkerObjectFromJson(json["object"]);
+		optional<LinkerObject> runtimeObject = linkerObjectFromJson(json["runtimeObject"]);
+		if (!object || !runtimeObject)
+			return nullopt;
+
+		return Entry{
+			move(*object),
+			move(*runtimeObject),
+			json["sourceMapping"].asString(),
+			json["runtimeSourceMapping"].asString(),
+			json["generatedSources"],
+			json["runtimeGeneratedSources"]
+		};
+	};
+
+	optional<Entry> entry;
+	try
+	{
+		entry = parseEntry();
+	}
+	catch (...)
+	{
+		// Unreadable or corrupt entries are cache misses.
+		entry.reset();
+	}
+
+	lock_guard<mutex> lock(m_statisticsMutex);
+	if (entry)
+		++m_statistics.hits;
+	else
+		++m_statistics.misses;
+	return entry;
+}
+
+void CompilationCache::store(h256 const& _key, Entry const& _entry)
+{
+	Json::Value json{Json::objectValue};
+	json["version"] = entryFormatVersion;
+	json["key"] = _key.hex();
+	json["object"] = linkerObjectToJson(_entry.object);
+	json["runtimeObject"] = linkerObjectToJson(_entry.runtimeObject);
+	json["sourceMapping"] = _entry.sourceMapping;
+	json["runtimeSourceMapping"] = _entry.runtimeSourceMapping;
+	json["generatedSources"] = _entry.generatedSources;
+	json["runtimeGeneratedSources"] = _entry.runtimeGeneratedSources;
+
+	fs::path path = entryPath(_key);
+	// The name of the temporary file has to be unique among all processes using the cache.
+	fs::path temporaryPath = path;
+	temporaryPath += "." + to_string(random_device{}()) + ".tmp";
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+	{
+		ofstream file(temporaryPath.string(), ios::binary | ios::trunc);
+		file << jsonCompactPrint(json);
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	// Renaming is atomic, concurrent writers of the same entry write the same content.
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+
+	lock_guard<mutex> lock(m_statisticsMutex);
+	++m_statistics.stores;
+}
+
+CompilationCache::Statistics CompilationCache::statistics() const
+{
+	lock_guard<mutex> lock(m_statisticsMutex);
+	return m_statistics;
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
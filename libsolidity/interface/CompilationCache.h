@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache of compiled contracts that can be shared between compiler runs.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed cache of the results of the code generation of single contracts.
+ *
+ * The key of an entry is computed by the CompilerStack from the metadata of the contract,
+ * which covers the compiler version, all settings that influence the bytecode and the
+ * hashes of all sources the contract depends on.
+ *
+ * Every entry is stored in its own file. Files are written under a temporary name and
+ * then renamed, so several processes can use the same directory at the same time and
+ * readers never see partially written entries. Entries that cannot be read are treated
+ * as missing.
+ */
+class CompilationCache
+{
+public:
+	struct Entry
+	{
+		evmasm::LinkerObject object;
+		evmasm::LinkerObject runtimeObject;
+		std::string sourceMapping;
+		std::string runtimeSourceMapping;
+		Json::Value generatedSources;
+		Json::Value runtimeGeneratedSources;
+	};
+
+	struct Statistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t stores = 0;
+	};
+
+	/// Creates the cache, the directory is created on the first store.
+	explicit CompilationCache(boost::filesystem::path _directory);
+
+	/// @returns the entry stored under @a _key, if there is a readable one.
+	std::optional<Entry> find(util::h256 const& _key);
+	/// Stores @a _entry under @a _key. Failure to write the entry is not an error.
+	void store(util::h256 const& _key, Entry const& _entry);
+
+	Statistics statistics() const;
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+	mutable std::mutex m_statisticsMutex;
+	Statistics m_statistics;
+};
+
+}
@@ -47,6 +47,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -203,6 +204,13 @@ void CompilerStack::setMetadataHash(MetadataHash _metadataHash)
 	m_metadataHash = _metadataHash;
 }
 
+void CompilerStack::setCompilationCache(shared_ptr<CompilationCache> _cache)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set compilation cache before compiling."));
+	m_compilationCache = move(_cache);
+}
+
 void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _response)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -231,6 +239,7 @@ void CompilerStack::reset(bool _keepSettings)
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
+		m_compilationCache.reset();
 		m_stopAfter = State::CompilationSuccessful;
 	}
 	m_globalContext.reset();
@@ -570,7 +579,13 @@ bool CompilerStack::compile(State _stopAfter)
 						{
 							if (m_viaIR)
 								generateEVMFromIR(*contract);
-							else
+							else if (
+								!m_compilationCache ||
+								!contract->canBeDeployed() ||
+								// Already compiled because another contract depends on it.
+								otherCompilers.count(contract) ||
+								!loadFromCompilationCache(m_contracts.at(contract->fullyQualifiedName()))
+							)
 								compileContract(*contract, otherCompilers);
 						}
 						if (m_generateEwasm)
@@ -667,7 +682,12 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	Contract const& c = contract(_contractName);
+	return generatedSources(contract(_contractName), _runtime);
+}
+
+Json::Value const& CompilerStack::generatedSources(Contract const& _contract, bool _runtime) const
+{
+	Contract const& c = _contract;
 	util::LazyInit<Json::Value const> const& sources =
 		_runtime ?
 		c.runtimeGeneratedSources :
@@ -1225,6 +1245,14 @@ void CompilerStack::compileContract(
 
 	compiledContract.evmAssembly = compiler->assemblyPtr();
 	solAssert(compiledContract.evmAssembly, "");
+	compiledContract.evmRuntimeAssembly = compiler->runtimeAssemblyPtr();
+	solAssert(compiledContract.evmRuntimeAssembly, "");
+	_otherCompilers[compiledContract.contract] = compiler;
+
+	// Only the assembly was needed, the bytecode is already known.
+	if (compiledContract.loadedFromCompilationCache)
+		return;
+
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -1236,8 +1264,6 @@ void CompilerStack::compileContract(
 	}
 	solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
 
-	compiledContract.evmRuntimeAssembly = compiler->runtimeAssemblyPtr();
-	solAssert(compiledContract.evmRuntimeAssembly, "");
 	try
 	{
 		// Assemble runtime object.
@@ -1248,23 +1274,78 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
+	checkContractCodeSize(compiledContract);
+
+	if (m_compilationCache)
+	{
+		map<string, unsigned> indices = sourceIndices();
+		compiledContract.sourceMapping.emplace(
+			evmasm::AssemblyItem::computeSourceMapping(compiledContract.evmAssembly->items(), indices)
+		);
+		compiledContract.runtimeSourceMapping.emplace(
+			evmasm::AssemblyItem::computeSourceMapping(compiledContract.evmRuntimeAssembly->items(), indices)
+		);
+		m_compilationCache->store(compilationCacheKey(compiledContract), {
+			compiledContract.object,
+			compiledContract.runtimeObject,
+			*compiledContract.sourceMapping,
+			*compiledContract.runtimeSourceMapping,
+			generatedSources(compiledContract),
+			generatedSources(compiledContract, true)
+		});
+	}
+}
+
+h256 CompilerStack::compilationCacheKey(Contract const& _contract) const
+{
+	// The metadata covers the compiler version, the settings and the sources.
+	// The full version string is added to distinguish development builds.
+	// Source mappings and generated sources refer to sources by their index,
+	// which depends on the names of all sources.
+	Json::Value key{Json::objectValue};
+	key["compiler"] = VersionString;
+	key["metadata"] = metadata(_contract);
+	key["sources"] = Json::arrayValue;
+	for (auto const& source: m_sources)
+		key["sources"].append(source.first);
+	return keccak256(util::jsonCompactPrint(key));
+}
+
+bool CompilerStack::loadFromCompilationCache(Contract& _contract)
+{
+	solAssert(m_compilationCache, "");
+	optional<CompilationCache::Entry> entry = m_compilationCache->find(compilationCacheKey(_contract));
+	if (!entry)
+		return false;
+
+	_contract.object = move(entry->object);
+	_contract.runtimeObject = move(entry->runtimeObject);
+	_contract.sourceMapping.emplace(move(entry->sourceMapping));
+	_contract.runtimeSourceMapping.emplace(move(entry->runtimeSourceMapping));
+	_contract.generatedSources.init([&]{ return move(entry->generatedSources); });
+	_contract.runtimeGeneratedSources.init([&]{ return move(entry->runtimeGeneratedSources); });
+	_contract.loadedFromCompilationCache = true;
+	checkContractCodeSize(_contract);
+	return true;
+}
+
+void CompilerStack::checkContractCodeSize(Contract const& _contract)
+{
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
 	//   contract creation fails with an out of gas error.
 	if (
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
+		_contract.runtimeObject.bytecode.size() > 0x6000
 	)
 		m_errorReporter.warning(
 			5574_error,
-			_contract.location(),
+			_contract.contract->location(),
 			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
 			"This contract may not be deployable on mainnet. "
 			"Consider enabling the optimizer (with a low \"runs\" value!), "
 			"turning off revert strings, or using libraries."
 		);
-
-	_otherCompilers[compiledContract.contract] = compiler;
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1292,12 +1373,15 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
+	// Contracts created in free functions or internal library functions are not part of the
+	// contract dependencies, so the IR of all contracts has to be available.
 	map<ContractDefinition const*, string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
 	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	tie(compiledContract.yulIR, compiledContract.yulIROptimized, compiledContract.yulIROptimizedObject) =
+		generator.run(_contract, otherYulSources);
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1314,10 +1398,14 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	// Continue with the already parsed object of the optimized IR instead of re-parsing
+	// its printed form. The object is moved out, since it is not needed afterwards.
+	// It was already optimized by the IRGenerator using the same settings, so the
+	// optimizer is not run again. Note that its source locations refer to the unoptimized IR.
+	solAssert(compiledContract.yulIROptimizedObject, "");
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
+	bool analysisSuccessful = stack.analyzeObject(move(compiledContract.yulIROptimizedObject));
+	solAssert(analysisSuccessful, "");
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
@@ -1480,6 +1568,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.optimizeYulFunctionsSeparately)
+				details["yulDetails"]["separateFunctions"] = true;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -67,11 +67,17 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
 // forward declarations
 class ASTNode;
+class CompilationCache;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
@@ -210,6 +216,12 @@ public:
 	/// @param _metadataHash can be IPFS, Bzzr1, None
 	void setMetadataHash(MetadataHash _metadataHash);
 
+	/// Sets the cache used to look up and store the bytecode of contracts compiled by the
+	/// legacy code generator. Only the bytecode, the source mappings and the generated sources
+	/// of contracts found in the cache are available, there is no assembly for them.
+	/// Must be set before compiling.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache);
+
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
@@ -377,6 +389,9 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Analyzed object of the optimized experimental Yul IR. Handed over to (and consumed by)
+		/// the EVM code generation so that it does not have to re-parse yulIROptimized.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -388,6 +403,9 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// True if the bytecode was taken from the compilation cache. The contract is then
+		/// only compiled if another contract needs its assembly.
+		bool loadedFromCompilationCache = false;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -414,6 +432,14 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// @returns the key of the contract in the compilation cache.
+	util::h256 compilationCacheKey(Contract const& _contract) const;
+	/// Takes the bytecode of the contract from the compilation cache.
+	/// @returns false if it is not in the cache.
+	bool loadFromCompilationCache(Contract& _contract);
+	/// Emits the warning about contracts exceeding the EIP-170 size limit, if necessary.
+	void checkContractCodeSize(Contract const& _contract);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -464,6 +490,9 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const&) const;
 
+	/// @returns the generated sources of the contract, also if compilation is not finished yet.
+	Json::Value const& generatedSources(Contract const& _contract, bool _runtime = false) const;
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -499,6 +528,7 @@ private:
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
+	std::shared_ptr<CompilationCache> m_compilationCache;
 	bool m_parserErrorRecovery = false;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
@@ -97,6 +97,7 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
+			optimizeYulFunctionsSeparately == _other.optimizeYulFunctionsSeparately &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -125,9 +126,16 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Apply the steps of the Yul optimiser that only work on a single function to every
+	/// function separately (concurrently if @a concurrent is set). Changes the names of the
+	/// variables introduced by the optimiser.
+	bool optimizeYulFunctionsSeparately = false;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Use the threads of the shared thread pool where this does not change the result.
+	/// Not compared by operator==, since it does not affect the output.
+	bool concurrent = false;
 };
 
 }
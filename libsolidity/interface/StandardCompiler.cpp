@@ -34,7 +34,10 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
 
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/exception/diagnostic_information.hpp>
 
 #include <algorithm>
 #include <optional>
@@ -287,6 +290,25 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output was requested that needs the EVM assembly, which is not
+/// available for contracts taken from the compilation cache.
+bool isEvmAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	static vector<string> const outputsThatRequireEvmAssembly{
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+	};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireEvmAssembly)
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEwasmRequested(Json::Value const& _outputSelection)
@@ -396,6 +418,81 @@ Json::Value collectEVMObject(
 	return output;
 }
 
+/// Writes the output of a Solidity compilation and computes the output of each contract and
+/// the ASTs only when they are reached, so that they never have to be held in memory together.
+/// The stream is flushed before the output of each contract is computed.
+///
+/// The values to replace are identified by their address in the written output rather than
+/// by their content, since member names like source names are chosen by the user.
+class StreamingOutputWriter: public util::CompactJsonWriter
+{
+public:
+	StreamingOutputWriter(
+		ostream& _stream,
+		ASTJsonConverter& _astConverter,
+		function<Json::Value(string const&)> _contractOutput,
+		Json::Value _errors
+	):
+		CompactJsonWriter(_stream),
+		m_astConverter(_astConverter),
+		m_contractOutput(move(_contractOutput)),
+		m_errors(move(_errors))
+	{}
+
+	/// Replaces @a _placeholder by the output of the contract @a _contractName.
+	void addContractPlaceholder(Json::Value const& _placeholder, string _contractName)
+	{
+		solAssert(_placeholder.isObject(), "");
+		m_contractPlaceholders[&_placeholder] = move(_contractName);
+	}
+	/// Replaces @a _placeholder by the errors, including the ones that occur while the output
+	/// of the contracts is computed. It has to be written after all contracts.
+	void setErrorsPlaceholder(Json::Value const& _placeholder)
+	{
+		solAssert(_placeholder.isObject(), "");
+		m_errorsPlaceholder = &_placeholder;
+	}
+
+protected:
+	optional<Json::Value> expand(Json::Value const& _object) override
+	{
+		if (&_object == m_errorsPlaceholder)
+			return m_errors.empty() ? Json::Value{} : m_errors;
+		if (auto contractName = m_contractPlaceholders.find(&_object); contractName != m_contractPlaceholders.end())
+			return contractOutput(contractName->second);
+		return m_astConverter.expandPlaceholder(_object);
+	}
+
+private:
+	Json::Value contractOutput(string const& _contractName)
+	{
+		m_stream.flush();
+		try
+		{
+			return m_contractOutput(_contractName);
+		}
+		catch (...)
+		{
+			// Parts of the output have already been written, so the error cannot replace it.
+			// The contract is left out instead.
+			m_errors.append(formatError(
+				false,
+				"InternalCompilerError",
+				"general",
+				"Internal exception while computing the output of " + _contractName + ": " +
+				boost::current_exception_diagnostic_information()
+			));
+			return Json::nullValue;
+		}
+	}
+
+	ASTJsonConverter& m_astConverter;
+	function<Json::Value(string const&)> m_contractOutput;
+	Json::Value m_errors;
+	map<Json::Value const*, string> m_contractPlaceholders;
+	Json::Value const* m_errorsPlaceholder = nullptr;
+};
+
 std::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> const& _keys, string const& _name)
 {
 	if (!!_input && !_input.isObject())
@@ -434,7 +531,7 @@ std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"engine", "targets", "timeout"};
+	static set<string> keys{"engine", "solverStrategy", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -600,12 +697,14 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "separateFunctions"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "separateFunctions", settings.optimizeYulFunctionsSeparately))
+				return *error;
 		}
 	}
 	return { std::move(settings) };
@@ -927,10 +1026,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("solverStrategy"))
+	{
+		if (!modelCheckerSettings["solverStrategy"].isString())
+			return formatFatalError("JSONError", "settings.modelChecker.solverStrategy must be a string.");
+		std::optional<smtutil::SMTPortfolioStrategy> strategy = ModelCheckerSettings::solverStrategyFromString(modelCheckerSettings["solverStrategy"].asString());
+		if (!strategy)
+			return formatFatalError("JSONError", "Invalid model checker solver strategy requested.");
+		ret.modelCheckerSettings.solverStrategy = *strategy;
+	}
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, ostream* _output)
 {
 	CompilerStack compilerStack(m_readFile);
 
@@ -953,6 +1062,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	if (m_compilationCache && !isEvmAssemblyRequested(_inputsAndSettings.outputSelection))
+		compilerStack.setCompilationCache(m_compilationCache);
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1102,6 +1213,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	bool const wildcardMatchesExperimental = false;
 
+	ASTJsonConverter astConverter(compilerStack.state(), compilerStack.sourceIndices());
+	// The ASTs are only written after the errors, so an internal error while converting them
+	// could not be reported anymore. They are converted once before anything is written instead.
+	optional<ASTJsonConverter> astChecker;
+	ostream discardedOutput(nullptr);
+	if (_output)
+		astChecker.emplace(compilerStack.state(), compilerStack.sourceIndices());
 	output["sources"] = Json::objectValue;
 	unsigned sourceIndex = 0;
 	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
@@ -1110,108 +1228,148 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			Json::Value sourceResult = Json::objectValue;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			{
+				if (astChecker)
+					astChecker->printCompact(discardedOutput, compilerStack.ast(sourceName));
+				sourceResult["ast"] = _output ?
+					astConverter.placeholder(compilerStack.ast(sourceName)) :
+					astConverter.toJson(compilerStack.ast(sourceName));
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	struct ContractArtifact
 	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
+		/// Names that request the artifact in the output selection. The first one
+		/// is the path of the artifact in the output of the contract.
+		vector<string> names;
+		/// Whether the artifact is only available after successful compilation.
+		bool needsCompilation;
+		/// Computes the artifact for the given contract. Each artifact only queries the
+		/// compiler stack for what it needs, which computes it on first use.
+		function<Json::Value(string const&)> compute;
+	};
+	vector<ContractArtifact> contractArtifacts{
 		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
+		{{"abi"}, false, [&](string const& _contract) { return compilerStack.contractABI(_contract); }},
+		{{"storageLayout"}, false, [&](string const& _contract) { return compilerStack.storageLayout(_contract); }},
+		{{"metadata"}, false, [&](string const& _contract) { return Json::Value(compilerStack.metadata(_contract)); }},
+		{{"userdoc"}, false, [&](string const& _contract) { return compilerStack.natspecUser(_contract); }},
+		{{"devdoc"}, false, [&](string const& _contract) { return compilerStack.natspecDev(_contract); }},
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
+		{{"ir"}, true, [&](string const& _contract) { return Json::Value(compilerStack.yulIR(_contract)); }},
+		{{"irOptimized"}, true, [&](string const& _contract) { return Json::Value(compilerStack.yulIROptimized(_contract)); }},
 		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
-
+		{{"ewasm.wast"}, true, [&](string const& _contract) { return Json::Value(compilerStack.ewasm(_contract)); }},
+		{{"ewasm.wasm"}, true, [&](string const& _contract) { return Json::Value(compilerStack.ewasmObject(_contract).toHex()); }},
 		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		{{"evm.assembly"}, true, [&](string const& _contract) { return Json::Value(compilerStack.assemblyString(_contract, sourceList)); }},
+		{{"evm.legacyAssembly"}, true, [&](string const& _contract) { return compilerStack.assemblyJSON(_contract); }},
+		{{"evm.methodIdentifiers"}, false, [&](string const& _contract) { return compilerStack.methodIdentifiers(_contract); }},
+		{{"evm.gasEstimates"}, true, [&](string const& _contract) { return compilerStack.gasEstimates(_contract); }}
+	};
+	// The components of the EVM objects are separate artifacts, so that e.g. requesting
+	// only the bytecode does not compute the source mapping or the generated sources.
+	for (bool runtime: {false, true})
+	{
+		string const prefix = runtime ? "evm.deployedBytecode." : "evm.bytecode.";
+		auto object = [&compilerStack, runtime](string const& _contract) -> evmasm::LinkerObject const& {
+			return runtime ? compilerStack.runtimeObject(_contract) : compilerStack.object(_contract);
+		};
+		contractArtifacts.push_back({{prefix + "object"}, true, [=](string const& _contract) {
+			return Json::Value(object(_contract).toHex());
+		}});
+		contractArtifacts.push_back({{prefix + "opcodes"}, true, [=](string const& _contract) {
+			return Json::Value(evmasm::disassemble(object(_contract).bytecode));
+		}});
+		contractArtifacts.push_back({{prefix + "sourceMap"}, true, [&compilerStack, runtime](string const& _contract) {
+			string const* sourceMap = runtime ?
+				compilerStack.runtimeSourceMapping(_contract) :
+				compilerStack.sourceMapping(_contract);
+			return Json::Value(sourceMap ? *sourceMap : "");
+		}});
+		contractArtifacts.push_back({{prefix + "generatedSources"}, true, [&compilerStack, runtime](string const& _contract) {
+			return compilerStack.generatedSources(_contract, runtime);
+		}});
+		contractArtifacts.push_back({{prefix + "linkReferences"}, true, [=](string const& _contract) {
+			return formatLinkReferences(object(_contract).linkReferences);
+		}});
+		if (runtime)
+			contractArtifacts.push_back({{prefix + "immutableReferences"}, true, [=](string const& _contract) {
+				return formatImmutableReferences(object(_contract).immutableReferences);
+			}});
+	}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+	auto splitContractName = [](string const& _contractName)
+	{
+		size_t colon = _contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		return make_pair(_contractName.substr(0, colon), _contractName.substr(colon + 1));
+	};
+	auto requestedArtifacts = [&](string const& _file, string const& _name)
+	{
+		vector<ContractArtifact const*> artifacts;
+		for (ContractArtifact const& artifact: contractArtifacts)
+			if (
+				(compilationSuccess || !artifact.needsCompilation) &&
+				isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, artifact.names, wildcardMatchesExperimental)
+			)
+				artifacts.push_back(&artifact);
+		return artifacts;
+	};
+	auto contractOutput = [&](string const& _contractName)
+	{
+		auto [file, name] = splitContractName(_contractName);
+		Json::Value contractData(Json::objectValue);
+		for (ContractArtifact const* artifact: requestedArtifacts(file, name))
+		{
+			vector<string> path;
+			boost::algorithm::split(path, artifact->names.front(), boost::is_any_of("."));
+			Json::Value* target = &contractData;
+			for (string const& member: path)
+				target = &(*target)[member];
+			*target = artifact->compute(_contractName);
+		}
+		return contractData;
+	};
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+	vector<string> streamedContracts;
+	Json::Value contractsOutput = Json::objectValue;
+	if (analysisPerformed)
+		for (string const& contractName: compilerStack.contractNames())
+		{
+			auto [file, name] = splitContractName(contractName);
+			if (requestedArtifacts(file, name).empty())
+				continue;
+			if (_output)
+			{
+				contractsOutput[file][name] = Json::objectValue;
+				streamedContracts.push_back(contractName);
+			}
+			else
+				contractsOutput[file][name] = contractOutput(contractName);
+		}
+	if (!contractsOutput.empty())
+		output["contracts"] = move(contractsOutput);
 
-		if (!contractData.empty())
+	if (_output)
+	{
+		// The errors that occur while the contracts are written are only known afterwards.
+		Json::Value errors{Json::arrayValue};
+		output.removeMember("errors", &errors);
+		output["errors"] = Json::objectValue;
+
+		// The placeholders are registered once the output is complete, so that their addresses do not change.
+		StreamingOutputWriter writer(*_output, astConverter, contractOutput, move(errors));
+		writer.setErrorsPlaceholder(output["errors"]);
+		for (string const& contractName: streamedContracts)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			auto [file, name] = splitContractName(contractName);
+			writer.addContractPlaceholder(output["contracts"][file][name], contractName);
 		}
+		writer.write(output);
+		return Json::nullValue;
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
 	return output;
 }
@@ -1319,6 +1477,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, ostream* _output) noexcept
 {
 	YulStringRepository::reset();
 
@@ -1329,7 +1492,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _output);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1380,3 +1543,34 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	Json::Value input;
+	string errors;
+	try
+	{
+		if (!util::jsonParseStrict(_input, input, &errors))
+		{
+			_output << util::jsonCompactPrint(formatFatalError("JSONError", errors)) << flush;
+			return;
+		}
+	}
+	catch (...)
+	{
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}" << flush;
+		return;
+	}
+
+	Json::Value output = compile(input, &_output);
+	if (!output.isNull())
+		try
+		{
+			_output << util::jsonCompactPrint(output);
+		}
+		catch (...)
+		{
+			_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		}
+	_output << flush;
+}
@@ -26,6 +26,7 @@
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -42,8 +43,14 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback()):
-		m_readFile(std::move(_readFile))
+	/// @param _compilationCache the compilation cache, if any. It is deliberately not part
+	/// of the input, which must not be able to make the compiler write files.
+	explicit StandardCompiler(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<CompilationCache> _compilationCache = nullptr
+	):
+		m_readFile(std::move(_readFile)),
+		m_compilationCache(std::move(_compilationCache))
 	{
 	}
 
@@ -53,6 +60,13 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as the above, but writes the output to @a _output. The output of every contract
+	/// and every AST is only computed when it is written, and the stream is flushed after
+	/// every contract, so the output of all contracts is never held in memory at the same time.
+	/// The output is the same, except that internal errors while computing the output of a
+	/// contract are reported as errors and the contract is left out. Other internal errors
+	/// after the output has been started cannot be reported in valid JSON anymore.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
 
 private:
 	struct InputsAndSettings
@@ -79,10 +93,17 @@ private:
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the compilation of @a _input. If @a _output is given, the output may be
+	/// written to it while it is computed, in which case null is returned.
+	Json::Value compile(Json::Value const& _input, std::ostream* _output) noexcept;
+
+	/// @returns the output of the compilation, or null if @a _output is given and the output
+	/// has been written to it.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, std::ostream* _output = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<CompilationCache> m_compilationCache;
 };
 
 }
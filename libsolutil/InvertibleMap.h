@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolutil/PersistentMap.h>
+
+#include <map>
+#include <set>
+
+namespace solidity::util
+{
+
+/**
+ * Map that also maintains the inverse relation, i.e. it can efficiently
+ * find and erase all keys mapped to a given value.
+ *
+ * The map itself is persistent, so taking a snapshot of `values` is cheap and
+ * the keys changed since the snapshot can be found via `forEachDifference`.
+ */
+template<typename K, typename V>
+struct InvertibleMap
+{
+	/// The actual map.
+	PersistentMap<K, V> values;
+	/// references[v] == {k | values[k] == v}
+	std::map<V, std::set<K>> references;
+
+	void set(K const& _key, V const& _value)
+	{
+		eraseKey(_key);
+		values.set(_key, _value);
+		references[_value].insert(_key);
+	}
+
+	void eraseKey(K const& _key)
+	{
+		V const* value = values.find(_key);
+		if (!value)
+			return;
+		auto referencesIt = references.find(*value);
+		referencesIt->second.erase(_key);
+		if (referencesIt->second.empty())
+			references.erase(referencesIt);
+		values.erase(_key);
+	}
+
+	/// Erases all keys mapped to @a _value.
+	void eraseValue(V const& _value)
+	{
+		auto it = references.find(_value);
+		if (it == references.end())
+			return;
+		for (K const& key: it->second)
+			values.erase(key);
+		references.erase(it);
+	}
+
+	void clear()
+	{
+		values.clear();
+		references.clear();
+	}
+};
+
+/**
+ * Relation that also maintains its inverse, i.e. it can efficiently
+ * find all elements that are related to a given element.
+ */
+template<typename T>
+struct InvertibleRelation
+{
+	/// forward[x] contains y iff (x, y) is in the relation.
+	std::map<T, std::set<T>> forward;
+	/// backward[y] contains x iff (x, y) is in the relation.
+	std::map<T, std::set<T>> backward;
+
+	/// Replaces all elements @a _key is related to by @a _values.
+	void set(T const& _key, std::set<T> _values)
+	{
+		eraseKey(_key);
+		for (T const& value: _values)
+			backward[value].insert(_key);
+		forward[_key] = std::move(_values);
+	}
+
+	/// Removes all pairs whose first element is @a _key.
+	void eraseKey(T const& _key)
+	{
+		auto it = forward.find(_key);
+		if (it == forward.end())
+			return;
+		for (T const& value: it->second)
+		{
+			auto backwardIt = backward.find(value);
+			backwardIt->second.erase(_key);
+			if (backwardIt->second.empty())
+				backward.erase(backwardIt);
+		}
+		forward.erase(it);
+	}
+
+	void clear()
+	{
+		forward.clear();
+		backward.clear();
+	}
+};
+
+}
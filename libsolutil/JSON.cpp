@@ -105,6 +105,13 @@ void removeNullMembersHelper(Json::Value& _json)
 		}
 }
 
+StreamWriterBuilder const& compactWriterBuilder()
+{
+	static map<string, Json::Value> settings{{"indentation", ""}};
+	static StreamWriterBuilder writerBuilder(settings);
+	return writerBuilder;
+}
+
 } // end anonymous namespace
 
 Json::Value removeNullMembers(Json::Value _json)
@@ -124,9 +131,62 @@ string jsonPrettyPrint(Json::Value const& _input)
 
 string jsonCompactPrint(Json::Value const& _input)
 {
-	static map<string, Json::Value> settings{{"indentation", ""}};
-	static StreamWriterBuilder writerBuilder(settings);
-	return print(_input, writerBuilder);
+	return print(_input, compactWriterBuilder());
+}
+
+CompactJsonWriter::CompactJsonWriter(ostream& _stream):
+	m_stream(_stream),
+	m_scalarWriter(compactWriterBuilder().newStreamWriter())
+{
+}
+
+CompactJsonWriter::~CompactJsonWriter() = default;
+
+void CompactJsonWriter::write(Json::Value const& _value)
+{
+	optional<Json::Value> expanded = _value.isObject() ? expand(_value) : nullopt;
+	writeExpanded(expanded ? *expanded : _value);
+}
+
+optional<Json::Value> CompactJsonWriter::expand(Json::Value const&)
+{
+	return nullopt;
+}
+
+void CompactJsonWriter::writeExpanded(Json::Value const& _value)
+{
+	if (_value.isObject())
+	{
+		m_stream << '{';
+		bool first = true;
+		// Members are iterated in the same order in which jsoncpp writes them.
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			optional<Json::Value> expanded = it->isObject() ? expand(*it) : nullopt;
+			if (expanded && expanded->isNull())
+				continue;
+			if (!first)
+				m_stream << ',';
+			first = false;
+			m_scalarWriter->write(Json::Value(it.name()), &m_stream);
+			m_stream << ':';
+			writeExpanded(expanded ? *expanded : *it);
+		}
+		m_stream << '}';
+	}
+	else if (_value.isArray())
+	{
+		m_stream << '[';
+		for (Json::ArrayIndex i = 0; i < _value.size(); ++i)
+		{
+			if (i > 0)
+				m_stream << ',';
+			write(_value[i]);
+		}
+		m_stream << ']';
+	}
+	else
+		m_scalarWriter->write(_value, &m_stream);
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
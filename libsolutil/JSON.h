@@ -25,6 +25,9 @@
 
 #include <json/json.h>
 
+#include <memory>
+#include <optional>
+#include <ostream>
 #include <string>
 
 namespace solidity::util {
@@ -38,6 +41,38 @@ std::string jsonPrettyPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) without indentation
 std::string jsonCompactPrint(Json::Value const& _input);
 
+/**
+ * Writes JSON values to a stream in the same format as jsonCompactPrint, without
+ * serialising them into a string first.
+ *
+ * Objects and arrays are written member by member. Derived classes can override
+ * expand to replace placeholder objects by values that are only computed when
+ * they are written.
+ */
+class CompactJsonWriter
+{
+public:
+	explicit CompactJsonWriter(std::ostream& _stream);
+	virtual ~CompactJsonWriter();
+
+	void write(Json::Value const& _value);
+
+protected:
+	/// Called for every object before it is written.
+	/// @returns the value to write instead of @a _object, if it is a placeholder.
+	/// Members of objects that are expanded to null are left out.
+	virtual std::optional<Json::Value> expand(Json::Value const& _object);
+
+	std::ostream& m_stream;
+
+private:
+	/// Writes @a _value without expanding it.
+	void writeExpanded(Json::Value const& _value);
+
+	/// Writer for everything but arrays and objects, formats them exactly like jsonCompactPrint.
+	std::unique_ptr<Json::StreamWriter> m_scalarWriter;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
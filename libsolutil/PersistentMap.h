@@ -0,0 +1,242 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace solidity::util
+{
+
+/**
+ * Ordered map with value semantics whose copies share their structure.
+ *
+ * Copying the map is constant-time. Modifications only copy the nodes on the path
+ * to the modified key, all other nodes stay shared between the copies.
+ *
+ * The map is a treap whose node priorities are derived from the hashes of the keys,
+ * so the shape of the tree only depends on the set of keys and not on the order of
+ * insertions. Because of that, comparing a map with an older copy of itself
+ * can skip all shared subtrees and only takes time proportional to the number of
+ * modifications in between (times the depth of the tree).
+ */
+template<typename K, typename V, typename Compare = std::less<K>, typename Hash = std::hash<K>>
+class PersistentMap
+{
+public:
+	/// @returns a pointer to the value @a _key is mapped to or nullptr if there is none.
+	V const* find(K const& _key) const
+	{
+		Node const* node = m_root.get();
+		while (node)
+			if (Compare{}(_key, node->key))
+				node = node->left.get();
+			else if (Compare{}(node->key, _key))
+				node = node->right.get();
+			else
+				return &node->value;
+		return nullptr;
+	}
+	bool count(K const& _key) const { return find(_key) != nullptr; }
+
+	void set(K const& _key, V const& _value) { m_root = insert(m_root, _key, _value, priority(_key)); }
+	void erase(K const& _key) { m_root = remove(m_root, _key); }
+	void clear() { m_root.reset(); }
+
+	bool empty() const { return !m_root; }
+
+	/// Calls @a _f(key, value) for all entries in the order of the keys.
+	template<typename F>
+	void forEach(F&& _f) const { forEach(m_root.get(), _f); }
+
+	/// Calls @a _f(key) for all keys of this map that are not present in @a _other
+	/// or mapped to a different value there, in the order of the keys.
+	/// Subtrees shared with @a _other are skipped.
+	template<typename F>
+	void forEachDifference(PersistentMap const& _other, F&& _f) const
+	{
+		forEachDifference(m_root, _other.m_root, _f);
+	}
+
+private:
+	struct Node;
+	using NodePtr = std::shared_ptr<Node const>;
+
+	struct Node
+	{
+		K key;
+		V value;
+		uint64_t priority;
+		NodePtr left;
+		NodePtr right;
+	};
+
+	struct Split
+	{
+		NodePtr less;
+		Node const* match = nullptr;
+		NodePtr greater;
+	};
+
+	static uint64_t priority(K const& _key)
+	{
+		// The hash is mixed because it can be correlated with the order of the keys
+		// (YulString compares the hashes first), which would degenerate the tree.
+		uint64_t x = static_cast<uint64_t>(Hash{}(_key));
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9u;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebu;
+		return x ^ (x >> 31);
+	}
+
+	/// Total order on the nodes that determines the shape of the tree.
+	/// Ties in the priority are broken by the keys.
+	static bool above(uint64_t _priority, K const& _key, Node const& _node)
+	{
+		if (_priority != _node.priority)
+			return _priority > _node.priority;
+		return Compare{}(_key, _node.key);
+	}
+
+	static NodePtr makeNode(Node const& _node, NodePtr _left, NodePtr _right)
+	{
+		return std::make_shared<Node const>(Node{_node.key, _node.value, _node.priority, std::move(_left), std::move(_right)});
+	}
+
+	/// Splits @a _node into the entries with keys less than @a _key, the entry
+	/// with key @a _key (if any) and the entries with keys greater than @a _key.
+	static Split split(NodePtr const& _node, K const& _key)
+	{
+		if (!_node)
+			return {};
+		if (Compare{}(_key, _node->key))
+		{
+			Split s = split(_node->left, _key);
+			s.greater = makeNode(*_node, std::move(s.greater), _node->right);
+			return s;
+		}
+		else if (Compare{}(_node->key, _key))
+		{
+			Split s = split(_node->right, _key);
+			s.less = makeNode(*_node, _node->left, std::move(s.less));
+			return s;
+		}
+		else
+			return {_node->left, _node.get(), _node->right};
+	}
+
+	/// Merges two trees where all keys in @a _less are less than all keys in @a _greater.
+	static NodePtr merge(NodePtr const& _less, NodePtr const& _greater)
+	{
+		if (!_less)
+			return _greater;
+		if (!_greater)
+			return _less;
+		if (above(_less->priority, _less->key, *_greater))
+			return makeNode(*_less, _less->left, merge(_less->right, _greater));
+		else
+			return makeNode(*_greater, merge(_less, _greater->left), _greater->right);
+	}
+
+	static NodePtr insert(NodePtr const& _node, K const& _key, V const& _value, uint64_t _priority)
+	{
+		if (!_node)
+			return std::make_shared<Node const>(Node{_key, _value, _priority, nullptr, nullptr});
+		if (Compare{}(_key, _node->key))
+		{
+			if (above(_priority, _key, *_node))
+				return splitAndInsert(_node, _key, _value, _priority);
+			NodePtr left = insert(_node->left, _key, _value, _priority);
+			return left == _node->left ? _node : makeNode(*_node, std::move(left), _node->right);
+		}
+		else if (Compare{}(_node->key, _key))
+		{
+			if (above(_priority, _key, *_node))
+				return splitAndInsert(_node, _key, _value, _priority);
+			NodePtr right = insert(_node->right, _key, _value, _priority);
+			return right == _node->right ? _node : makeNode(*_node, _node->left, std::move(right));
+		}
+		else if (_node->value == _value)
+			return _node;
+		else
+			return std::make_shared<Node const>(Node{_key, _value, _priority, _node->left, _node->right});
+	}
+
+	/// Inserts a new entry above @a _node, which does not contain @a _key.
+	static NodePtr splitAndInsert(NodePtr const& _node, K const& _key, V const& _value, uint64_t _priority)
+	{
+		Split s = split(_node, _key);
+		return std::make_shared<Node const>(Node{_key, _value, _priority, std::move(s.less), std::move(s.greater)});
+	}
+
+	static NodePtr remove(NodePtr const& _node, K const& _key)
+	{
+		if (!_node)
+			return _node;
+		if (Compare{}(_key, _node->key))
+		{
+			NodePtr left = remove(_node->left, _key);
+			return left == _node->left ? _node : makeNode(*_node, std::move(left), _node->right);
+		}
+		else if (Compare{}(_node->key, _key))
+		{
+			NodePtr right = remove(_node->right, _key);
+			return right == _node->right ? _node : makeNode(*_node, _node->left, std::move(right));
+		}
+		else
+			return merge(_node->left, _node->right);
+	}
+
+	template<typename F>
+	static void forEach(Node const* _node, F& _f)
+	{
+		if (!_node)
+			return;
+		forEach(_node->left.get(), _f);
+		_f(_node->key, _node->value);
+		forEach(_node->right.get(), _f);
+	}
+
+	template<typename F>
+	static void forEachDifference(NodePtr const& _node, NodePtr const& _other, F& _f)
+	{
+		if (_node == _other || !_node)
+			return;
+		if (!_other)
+		{
+			auto reportKey = [&](K const& _key, V const&) { _f(_key); };
+			forEach(_node.get(), reportKey);
+			return;
+		}
+		// Both trees have the same shape for the same set of keys, so as long as the
+		// roots agree, the recursion continues on the (potentially shared) children.
+		Split s =
+			Compare{}(_node->key, _other->key) || Compare{}(_other->key, _node->key) ?
+			split(_other, _node->key) :
+			Split{_other->left, _other.get(), _other->right};
+		forEachDifference(_node->left, s.less, _f);
+		if (!s.match || !(s.match->value == _node->value))
+			_f(_node->key);
+		forEachDifference(_node->right, s.greater, _f);
+	}
+
+	NodePtr m_root;
+};
+
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+/// The pool the current thread is a worker of, if any.
+thread_local ThreadPool const* t_currentPool = nullptr;
+
+}
+
+ThreadPool::ThreadPool([[maybe_unused]] size_t _workerCount)
+{
+#ifdef HAVE_THREADS
+	for (size_t i = 0; i < _workerCount; ++i)
+		m_workers.emplace_back([this]() {
+			t_currentPool = this;
+			work();
+		});
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool(thread::hardware_concurrency() > 1 ? thread::hardware_concurrency() : 0);
+	return pool;
+}
+
+bool ThreadPool::enqueue(function<void()> _task)
+{
+	if (m_workers.empty() || t_currentPool == this)
+		return false;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_tasks.emplace_back(move(_task));
+	}
+	m_taskAvailable.notify_one();
+	return true;
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty())
+				return;
+			task = move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed set of worker threads that run submitted tasks.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * A fixed number of worker threads that run the submitted tasks in the order of submission.
+ *
+ * The workers live as long as the pool, so that state a task keeps per thread (e.g. the
+ * simplification rules of the optimisers) is only built once per worker.
+ * Tasks submitted from a worker of the pool are run immediately, so that a task can wait for
+ * tasks it submitted without the risk of a deadlock. If the compiler is built without thread
+ * support, the pool has no workers and all tasks are run immediately as well.
+ */
+class ThreadPool
+{
+public:
+	/// Creates a pool with @a _workerCount workers (none if threads are not supported).
+	explicit ThreadPool(size_t _workerCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// @returns the pool shared by the whole compiler. It is created on first use with
+	/// one worker per hardware thread, but none if there is only a single one.
+	static ThreadPool& shared();
+
+	size_t workerCount() const { return m_workers.size(); }
+
+	/// Runs @a _task in one of the workers and @returns the future of its result.
+	/// Exceptions thrown by the task are rethrown by the future.
+	template <typename Task>
+	std::future<std::invoke_result_t<Task>> submit(Task _task)
+	{
+		auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Task>()>>(std::move(_task));
+		auto result = task->get_future();
+		if (!enqueue([task]() { (*task)(); }))
+			(*task)();
+		return result;
+	}
+
+private:
+	/// Adds @a _task to the queue. @returns false if it has to be run by the caller instead.
+	bool enqueue(std::function<void()> _task);
+	void work();
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	std::deque<std::function<void()>> m_tasks;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+}
@@ -26,11 +26,267 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// Upper bound on the number of parsed templates that are kept, so that templates
+/// generated at runtime do not make the cache grow without limit.
+size_t const maxCachedTemplates = 4096;
+
+/// @returns the end of the parameter name starting at @a _pos, which is @a _pos itself
+/// if there is no valid parameter name at that position.
+size_t parameterNameEnd(string_view _template, size_t _pos)
+{
+	while (_pos < _template.size() && isParameterCharacter(_template[_pos]))
+		++_pos;
+	return _pos;
+}
+
+/// Part of a template, parsed once so that rendering does not have to scan the template text.
+struct Element;
+
+/// Sequence of elements that were parsed from @a source.
+struct Sequence
+{
+	/// Text of the (sub-)template, used in error messages.
+	string_view source;
+	vector<Element> elements;
+};
+
+struct Element
+{
+	enum class Kind { Text, Parameter, List, Condition };
+	Kind kind;
+	/// Name of the parameter, list or condition. Starts with "+" for conditional string parameters.
+	string name;
+	/// Text to be copied verbatim for Kind::Text.
+	string_view text;
+	/// Body of the list or the part that is used if the condition is true.
+	Sequence body;
+	/// Part that is used if the condition is false.
+	Sequence elseBody;
+};
+
+struct ParsedTemplate
+{
+	string text;
+	/// Refers to parts of @a text.
+	Sequence root;
+};
+
+pair<optional<Element>, size_t> parseElement(string_view _template, size_t _pos);
+
+/// Splits @a _template into text and tags. If a "<" does not start a valid tag, it is
+/// treated as text and matching continues at the next character.
+Sequence parse(string_view _template)
+{
+	Sequence sequence{_template, {}};
+	size_t textStart = 0;
+	size_t pos = 0;
+	while ((pos = _template.find('<', pos)) != string_view::npos)
+	{
+		auto [element, end] = parseElement(_template, pos);
+		if (!element)
+		{
+			// Not a tag, treat the '<' as text.
+			++pos;
+			continue;
+		}
+		if (pos > textStart)
+			sequence.elements.push_back(Element{Element::Kind::Text, {}, _template.substr(textStart, pos - textStart), {}, {}});
+		sequence.elements.emplace_back(move(*element));
+		pos = textStart = end;
+	}
+	if (textStart < _template.size())
+		sequence.elements.push_back(Element{Element::Kind::Text, {}, _template.substr(textStart), {}, {}});
+	return sequence;
+}
+
+/// @returns the tag starting at @a _pos (which has to be a "<") and the position after it,
+/// or nullopt if there is no valid tag at that position.
+pair<optional<Element>, size_t> parseElement(string_view _template, size_t _pos)
+{
+	// The alternatives are tried in this order: "<name>", "<#name>...</name>" and
+	// "<?name>...<!name>...</name>" (with an optional "+" in front of the name and an
+	// optional "<!name>..." part). The body always ends at the first closing tag.
+	size_t nameEnd = parameterNameEnd(_template, _pos + 1);
+	if (nameEnd > _pos + 1 && nameEnd < _template.size() && _template[nameEnd] == '>')
+	{
+		string name{_template.substr(_pos + 1, nameEnd - _pos - 1)};
+		return {Element{Element::Kind::Parameter, move(name), {}, {}, {}}, nameEnd + 1};
+	}
+	if (_pos + 1 >= _template.size() || (_template[_pos + 1] != '#' && _template[_pos + 1] != '?'))
+		return {nullopt, _pos};
+
+	bool isList = _template[_pos + 1] == '#';
+	size_t nameStart = _pos + 2;
+	size_t parameterStart = nameStart;
+	if (!isList && parameterStart < _template.size() && _template[parameterStart] == '+')
+		++parameterStart;
+	nameEnd = parameterNameEnd(_template, parameterStart);
+	if (nameEnd == parameterStart || nameEnd >= _template.size() || _template[nameEnd] != '>')
+		return {nullopt, _pos};
+
+	string name{_template.substr(nameStart, nameEnd - nameStart)};
+	string closingTag = "</" + name + ">";
+	size_t bodyStart = nameEnd + 1;
+	size_t closingPos = _template.find(closingTag, bodyStart);
+	if (closingPos == string_view::npos)
+		return {nullopt, _pos};
+	size_t end = closingPos + closingTag.size();
+
+	if (isList)
+	{
+		Sequence body = parse(_template.substr(bodyStart, closingPos - bodyStart));
+		return {Element{Element::Kind::List, move(name), {}, move(body), {}}, end};
+	}
+
+	string elseTag = "<!" + name + ">";
+	size_t elsePos = _template.find(elseTag, bodyStart);
+	if (elsePos != string_view::npos && elsePos < closingPos)
+	{
+		size_t elseStart = elsePos + elseTag.size();
+		Sequence body = parse(_template.substr(bodyStart, elsePos - bodyStart));
+		Sequence elseBody = parse(_template.substr(elseStart, closingPos - elseStart));
+		return {Element{Element::Kind::Condition, move(name), {}, move(body), move(elseBody)}, end};
+	}
+	Sequence body = parse(_template.substr(bodyStart, closingPos - bodyStart));
+	return {Element{Element::Kind::Condition, move(name), {}, move(body), Sequence{}}, end};
+}
+
+/// @returns the parsed form of @a _template, which is parsed only on first use.
+shared_ptr<ParsedTemplate const> parsedTemplate(string const& _template)
+{
+	// Keyed by views into the text owned by the parsed templates.
+	static unordered_map<string_view, shared_ptr<ParsedTemplate const>> cache;
+	static mutex cacheMutex;
+
+	lock_guard<mutex> lock(cacheMutex);
+	auto it = cache.find(_template);
+	if (it != cache.end())
+		return it->second;
+
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	auto parsed = make_shared<ParsedTemplate>();
+	parsed->text = _template;
+	parsed->root = parse(parsed->text);
+	cache.emplace(parsed->text, parsed);
+	return parsed;
+}
+
+/// Appends the rendered @a _sequence to @a _output. Inside lists, @a _listElement contains the
+/// parameters of the current list element and @a _listParameters is null.
+void renderSequence(
+	Sequence const& _sequence,
+	Whiskers::StringMap const& _parameters,
+	Whiskers::StringMap const* _listElement,
+	map<string, bool> const& _conditions,
+	Whiskers::StringListMap const* _listParameters,
+	string& _output
+)
+{
+	auto parameter = [&](string const& _name) -> string const*
+	{
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = _parameters.find(_name); it != _parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Element const& element: _sequence.elements)
+		switch (element.kind)
+		{
+		case Element::Kind::Text:
+			_output.append(element.text);
+			break;
+		case Element::Kind::Parameter:
+		{
+			string const* value = parameter(element.name);
+			assertThrow(
+				value,
+				WhiskersError,
+				"Value for tag " + element.name + " not provided.\n" +
+				"Template:\n" +
+				string(_sequence.source)
+			);
+			_output.append(*value);
+			break;
+		}
+		case Element::Kind::List:
+		{
+			assertThrow(
+				_listParameters && _listParameters->count(element.name),
+				WhiskersError, "List parameter " + element.name + " not set."
+			);
+			for (Whiskers::StringMap const& listElement: _listParameters->at(element.name))
+			{
+				for (auto const& listParameter: listElement)
+					assertThrow(
+						!_parameters.count(listParameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				// Lists cannot be nested, so the list parameters are not passed on.
+				renderSequence(element.body, _parameters, &listElement, _conditions, nullptr, _output);
+			}
+			break;
+		}
+		case Element::Kind::Condition:
+		{
+			bool conditionValue = false;
+			if (element.name[0] == '+')
+			{
+				string tag = element.name.substr(1);
+				string const* value = parameter(tag);
+				assertThrow(
+					value,
+					WhiskersError, "Tag " + tag + " used as condition but was not set."
+				);
+				conditionValue = !value->empty();
+			}
+			else
+			{
+				assertThrow(
+					_conditions.count(element.name),
+					WhiskersError, "Condition parameter " + element.name + " not set."
+				);
+				conditionValue = _conditions.at(element.name);
+			}
+			renderSequence(
+				conditionValue ? element.body : element.elseBody,
+				_parameters,
+				_listElement,
+				_conditions,
+				_listParameters,
+				_output
+			);
+			break;
+		}
+		}
+}
+
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -71,14 +327,17 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	shared_ptr<ParsedTemplate const> parsed = parsedTemplate(m_template);
+	string result;
+	result.reserve(m_template.size());
+	renderSequence(parsed->root, m_parameters, nullptr, m_conditions, &m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -115,116 +374,3 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 		);
 	}
 }
-
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
-
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
-				assertThrow(
-					_parameters.count(tag),
-					WhiskersError, "Tag " + tag + " used as condition but was not set."
-				);
-				conditionValue = !_parameters.at(tag).empty();
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
-
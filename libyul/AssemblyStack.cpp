@@ -91,6 +91,18 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+bool AssemblyStack::analyzeObject(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	m_errors.clear();
+	m_analysisSuccessful = false;
+	m_scanner.reset();
+	m_parserResult = move(_object);
+
+	return analyzeParsed();
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -185,7 +197,10 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
+		m_optimiserSettings.yulOptimiserSteps,
+		{},
+		m_optimiserSettings.optimizeYulFunctionsSeparately,
+		m_optimiserSettings.concurrent
 	);
 }
 
@@ -232,11 +247,10 @@ std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleW
 	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.assemble());
 	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
 	creationObject.assembly = assembly.assemblyString();
+	// There is no scanner if the object was not parsed by this stack.
+	string sourceName = m_scanner && m_scanner->charStream() ? m_scanner->charStream()->name() : "";
 	creationObject.sourceMappings = make_unique<string>(
-		evmasm::AssemblyItem::computeSourceMapping(
-			assembly.items(),
-			{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
-		)
+		evmasm::AssemblyItem::computeSourceMapping(assembly.items(), {{sourceName, 0}})
 	);
 
 	MachineAssemblyObject deployedObject;
@@ -264,10 +278,7 @@ std::pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleW
 		deployedObject.bytecode = make_shared<evmasm::LinkerObject>(runtimeAssembly.assemble());
 		deployedObject.assembly = runtimeAssembly.assemblyString();
 		deployedObject.sourceMappings = make_unique<string>(
-			evmasm::AssemblyItem::computeSourceMapping(
-				runtimeAssembly.items(),
-				{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
-			)
+			evmasm::AssemblyItem::computeSourceMapping(runtimeAssembly.items(), {{sourceName, 0}})
 		);
 	}
 
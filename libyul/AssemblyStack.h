@@ -79,6 +79,11 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the analysis step on an already parsed object (for example the result of
+	/// another AssemblyStack), returns false if it cannot be assembled.
+	/// Multiple calls overwrite the previous state.
+	bool analyzeObject(std::shared_ptr<Object> _object);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
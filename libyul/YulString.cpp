@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+mutex& resetCallbacksMutex()
+{
+	static mutex callbacksMutex;
+	return callbacksMutex;
+}
+}
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete chunk.load(memory_order_relaxed);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	// Use the high bits for the shard, the low bits are used by the buckets of the map.
+	Shard& shard = m_shards[static_cast<size_t>(h >> (64 - shardBits))];
+
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.hashToID.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return Handle{it->second, h};
+	size_t id = m_nextID.fetch_add(1, memory_order_relaxed);
+	// The string has to be stored before the ID is published via the index.
+	store(id, _string);
+	shard.hashToID.emplace_hint(range.second, make_pair(h, id));
+
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	{
+		lock_guard<mutex> lock(resetCallbacksMutex());
+		for (auto const& cb: resetCallbacks())
+			cb();
+	}
+	instance().clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(resetCallbacksMutex());
+	YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+}
+
+void YulStringRepository::clear()
+{
+	vector<unique_lock<mutex>> locks;
+	for (Shard& shard: m_shards)
+	{
+		locks.emplace_back(shard.mutex);
+		shard.hashToID.clear();
+	}
+	for (auto& chunk: m_chunks)
+		delete chunk.exchange(nullptr, memory_order_acq_rel);
+	m_nextID.store(1, memory_order_relaxed);
+	store(0, string{});
+}
+
+void YulStringRepository::store(size_t _id, string const& _string)
+{
+	size_t chunkIndex = _id >> chunkBits;
+	yulAssert(chunkIndex < maxChunks, "Too many distinct YulStrings.");
+	Chunk* chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+	if (!chunk)
+	{
+		// Several threads can start a new chunk at the same time, only one of them wins.
+		auto newChunk = make_unique<Chunk>();
+		if (m_chunks[chunkIndex].compare_exchange_strong(chunk, newChunk.get(), memory_order_acq_rel))
+			chunk = newChunk.release();
+	}
+	(*chunk)[_id & (chunkSize - 1)] = make_unique<string const>(_string);
+}
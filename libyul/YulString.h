@@ -21,13 +21,15 @@
 
 #pragma once
 
-#include <boost/noncopyable.hpp>
-
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include <string>
-#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -36,6 +38,10 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Strings can be interned concurrently from multiple threads: The hash index is split into
+/// shards that are locked individually and the string data is stored in chunks that never move,
+/// so that looking up the string of an existing ID does not need any lock.
 class YulStringRepository
 {
 public:
@@ -51,22 +57,16 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	~YulStringRepository();
+
+	/// @returns the handle for @a _string, inserting the string if it is not yet known.
+	Handle stringToHandle(std::string const& _string);
+	/// @returns the string for the given ID. Does not lock, the ID has to come from a handle.
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		Chunk const* chunk = m_chunks[_id >> chunkBits].load(std::memory_order_acquire);
+		return *(*chunk)[_id & (chunkSize - 1)];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -82,31 +82,39 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and no
+	/// other thread can use the repository at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
+	static constexpr size_t chunkBits = 12;
+	static constexpr size_t chunkSize = size_t(1) << chunkBits;
+	static constexpr size_t maxChunks = size_t(1) << 14;
+	static constexpr size_t shardBits = 6;
+	using Chunk = std::array<std::unique_ptr<std::string const>, chunkSize>;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	/// Removes all strings apart from the empty string, which always has ID zero.
+	void clear();
+	/// Stores the string for a freshly allocated ID, allocating a new chunk if needed.
+	void store(size_t _id, std::string const& _string);
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -114,8 +122,9 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, size_t(1) << shardBits> m_shards;
+	std::array<std::atomic<Chunk*>, maxChunks> m_chunks{};
+	std::atomic<size_t> m_nextID{1};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -202,6 +202,22 @@ void EthAssemblyAdapter::appendJumpInstruction(evmasm::Instruction _instruction,
 	m_assembly.append(std::move(jump));
 }
 
+namespace
+{
+/// Assembly adapter that attributes all generated items to a single source location,
+/// regardless of the locations stored in the AST.
+class FixedLocationAssemblyAdapter: public EthAssemblyAdapter
+{
+public:
+	FixedLocationAssemblyAdapter(evmasm::Assembly& _assembly, SourceLocation const& _location):
+		EthAssemblyAdapter(_assembly)
+	{
+		EthAssemblyAdapter::setSourceLocation(_location);
+	}
+	void setSourceLocation(SourceLocation const&) override {}
+};
+}
+
 void CodeGenerator::assemble(
 	Block const& _parsedData,
 	AsmAnalysisInfo& _analysisInfo,
@@ -209,13 +225,18 @@ void CodeGenerator::assemble(
 	langutil::EVMVersion _evmVersion,
 	ExternalIdentifierAccess const& _identifierAccess,
 	bool _useNamedLabelsForFunctions,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	optional<SourceLocation> _sourceLocationOverride
 )
 {
-	EthAssemblyAdapter assemblyAdapter(_assembly);
+	unique_ptr<EthAssemblyAdapter> assemblyAdapter;
+	if (_sourceLocationOverride)
+		assemblyAdapter = make_unique<FixedLocationAssemblyAdapter>(_assembly, *_sourceLocationOverride);
+	else
+		assemblyAdapter = make_unique<EthAssemblyAdapter>(_assembly);
 	BuiltinContext builtinContext;
 	CodeTransform transform(
-		assemblyAdapter,
+		*assemblyAdapter,
 		_analysisInfo,
 		_parsedData,
 		EVMDialect::strictAssemblyForEVM(_evmVersion),
@@ -25,6 +25,7 @@
 #include <libyul/AsmAnalysis.h>
 #include <liblangutil/SourceLocation.h>
 #include <functional>
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -77,6 +78,8 @@ class CodeGenerator
 {
 public:
 	/// Performs code generation and appends generated to _assembly.
+	/// If @a _sourceLocationOverride is set, all generated items use this location
+	/// instead of the ones of the AST nodes.
 	static void assemble(
 		Block const& _parsedData,
 		AsmAnalysisInfo& _analysisInfo,
@@ -84,7 +87,8 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
 		bool _useNamedLabelsForFunctions = false,
-		bool _optimizeStackAllocation = false
+		bool _optimizeStackAllocation = false,
+		std::optional<langutil::SourceLocation> _sourceLocationOverride = std::nullopt
 	);
 };
 
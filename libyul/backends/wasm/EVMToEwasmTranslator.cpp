@@ -42,6 +42,8 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <mutex>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -60,6 +62,77 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// The polyfill parsed into an AST. It is shared by all translators
+/// and only copied into the translated code.
+class ParsedPolyfill
+{
+public:
+	static ParsedPolyfill& instance()
+	{
+		static ParsedPolyfill polyfill;
+		return polyfill;
+	}
+
+	/// @returns the polyfill and the names of its functions, parses it if necessary.
+	pair<shared_ptr<Block const>, set<YulString>> get()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_polyfill)
+			parse();
+		return {m_polyfill, m_functions};
+	}
+
+private:
+	ParsedPolyfill():
+		m_resetCallback([this]() {
+			// The AST refers to YulStrings.
+			lock_guard<mutex> lock(m_mutex);
+			m_polyfill.reset();
+			m_functions.clear();
+		})
+	{}
+
+	void parse()
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
+			"{" +
+				string(solidity::yul::wasm::polyfill::Arithmetic) +
+				string(solidity::yul::wasm::polyfill::Bitwise) +
+				string(solidity::yul::wasm::polyfill::Comparison) +
+				string(solidity::yul::wasm::polyfill::Conversion) +
+				string(solidity::yul::wasm::polyfill::Interface) +
+				string(solidity::yul::wasm::polyfill::Keccak) +
+				string(solidity::yul::wasm::polyfill::Logical) +
+				string(solidity::yul::wasm::polyfill::Memory) +
+			"}", ""))};
+		shared_ptr<Block> polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+		if (!errors.empty())
+		{
+			string message;
+			for (auto const& err: errors)
+				message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			yulAssert(false, message);
+		}
+
+		m_functions.clear();
+		for (auto const& statement: polyfill->statements)
+			m_functions.insert(std::get<FunctionDefinition>(statement).name);
+		m_polyfill = move(polyfill);
+	}
+
+	mutex m_mutex;
+	shared_ptr<Block const> m_polyfill;
+	set<YulString> m_functions;
+	YulStringRepository::ResetCallback m_resetCallback;
+};
+
+}
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
 	if (!m_polyfill)
@@ -114,29 +187,5 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 
 void EVMToEwasmTranslator::parsePolyfill()
 {
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
-	if (!errors.empty())
-	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
-		yulAssert(false, message);
-	}
-
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	tie(m_polyfill, m_polyfillFunctions) = ParsedPolyfill::instance().get();
 }
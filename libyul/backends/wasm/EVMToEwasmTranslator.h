@@ -36,11 +36,12 @@ public:
 	Object run(Object const& _object);
 
 private:
+	/// Retrieves the polyfill, which is only parsed once for all translators.
 	void parsePolyfill();
 
 	Dialect const& m_dialect;
 
-	std::shared_ptr<Block> m_polyfill;
+	std::shared_ptr<Block const> m_polyfill;
 	std::set<YulString> m_polyfillFunctions;
 };
 
@@ -16,7 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 /**
- * Optimiser component that calculates hash values for block prefixes.
+ * Optimiser components that calculate hash values for blocks and whole ASTs.
  */
 
 #include <libyul/optimiser/BlockHasher.h>
@@ -35,7 +35,7 @@ namespace
 {
 static constexpr uint64_t compileTimeLiteralHash(char const* _literal, size_t _n)
 {
-	return (_n == 0) ? BlockHasher::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * BlockHasher::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
+	return (_n == 0) ? Hasher::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * Hasher::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
 }
 
 template<size_t N>
@@ -194,3 +194,129 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ASTHasher::run(Block const& _block)
+{
+	ASTHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+uint64_t ASTHasher::run(Statement const& _statement)
+{
+	ASTHasher hasher;
+	hasher.visit(_statement);
+	return hasher.m_hash;
+}
+
+void ASTHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ASTHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ASTHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(compileTimeLiteralHash("ExpressionStatement"));
+	ASTWalker::operator()(_statement);
+}
+
+void ASTHasher::operator()(Assignment const& _assignment)
+{
+	hash64(compileTimeLiteralHash("Assignment"));
+	hash64(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void ASTHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(compileTimeLiteralHash("VariableDeclaration"));
+	hashTypedNames(_varDecl.variables);
+	hash8(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void ASTHasher::operator()(If const& _if)
+{
+	hash64(compileTimeLiteralHash("If"));
+	ASTWalker::operator()(_if);
+}
+
+void ASTHasher::operator()(Switch const& _switch)
+{
+	hash64(compileTimeLiteralHash("Switch"));
+	hash64(_switch.cases.size());
+	visit(*_switch.expression);
+	for (auto const& _case: _switch.cases)
+	{
+		hash8(_case.value ? 1 : 0);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void ASTHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hash64(_funDef.name.hash());
+	hashTypedNames(_funDef.parameters);
+	hashTypedNames(_funDef.returnVariables);
+	(*this)(_funDef.body);
+}
+
+void ASTHasher::operator()(ForLoop const& _loop)
+{
+	hash64(compileTimeLiteralHash("ForLoop"));
+	ASTWalker::operator()(_loop);
+}
+
+void ASTHasher::operator()(Break const&)
+{
+	hash64(compileTimeLiteralHash("Break"));
+}
+
+void ASTHasher::operator()(Continue const&)
+{
+	hash64(compileTimeLiteralHash("Continue"));
+}
+
+void ASTHasher::operator()(Leave const&)
+{
+	hash64(compileTimeLiteralHash("Leave"));
+}
+
+void ASTHasher::operator()(Block const& _block)
+{
+	hash64(compileTimeLiteralHash("Block"));
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTHasher::hashTypedNames(TypedNameList const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		hash64(name.name.hash());
+		hash64(name.type.hash());
+	}
+}
@@ -29,7 +29,6 @@
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
@@ -63,20 +62,29 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
-			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_storage[vars->first] = vars->second;
+		vector<YulString> keysToErase;
+		m_storage.values.forEach([&](YulString _key, YulString _value) {
+			if (
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value)
+			)
+				keysToErase.emplace_back(_key);
+		});
+		for (YulString const& key: keysToErase)
+			m_storage.eraseKey(key);
+		m_storage.set(vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_memory[vars->first] = vars->second;
+		vector<YulString> keysToErase;
+		m_memory.values.forEach([&](YulString _key, YulString) {
+			if (!m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key))
+				keysToErase.emplace_back(_key);
+		});
+		for (YulString const& key: keysToErase)
+			m_memory.eraseKey(key);
+		m_memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -115,8 +123,8 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	PersistentMap<YulString, YulString> storage = m_storage.values;
+	PersistentMap<YulString, YulString> memory = m_memory.values;
 
 	ASTModifier::operator()(_if);
 
@@ -134,8 +142,8 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		PersistentMap<YulString, YulString> storage = m_storage.values;
+		PersistentMap<YulString, YulString> memory = m_memory.values;
 		(*this)(_case.body);
 		joinKnowledge(storage, memory);
 
@@ -157,9 +165,9 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	// but this could be difficult if it is subclassed.
 	map<YulString, AssignedValue> value;
 	size_t loopDepth{0};
-	unordered_map<YulString, set<YulString>> references;
-	unordered_map<YulString, YulString> storage;
-	unordered_map<YulString, YulString> memory;
+	InvertibleRelation<YulString> references;
+	InvertibleMap<YulString, YulString> storage;
+	InvertibleMap<YulString, YulString> memory;
 	swap(m_value, value);
 	swap(m_loopDepth, loopDepth);
 	swap(m_references, references);
@@ -255,17 +263,17 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_references[name] = referencedVariables;
+		m_references.set(name, referencedVariables);
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
-			m_storage.erase(name);
+			m_storage.eraseKey(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_storage.eraseValue(name);
 			// assignment to slot denoted by "name"
-			m_memory.erase(name);
+			m_memory.eraseKey(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_memory.eraseValue(name);
 		}
 	}
 
@@ -278,9 +286,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				m_memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				m_storage.set(*key, variable);
 		}
 	}
 }
@@ -295,7 +303,7 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_references.eraseKey(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -318,23 +326,25 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	for (auto const& name: _variables)
+	{
+		m_storage.eraseKey(name);
+		m_storage.eraseValue(name);
+		m_memory.eraseKey(name);
+		m_memory.eraseValue(name);
+	}
 
 	// Also clear variables that reference variables to be cleared.
+	// Note that the loop also visits some of the variables added during iteration.
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_references)
-			if (names.count(variableToClear))
-				_variables.emplace(ref);
+		if (auto const* references = valueOrNullptr(m_references.backward, variableToClear))
+			_variables += *references;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_references.eraseKey(name);
 	}
 }
 
@@ -362,8 +372,8 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 }
 
 void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
+	PersistentMap<YulString, YulString> const& _olderStorage,
+	PersistentMap<YulString, YulString> const& _olderMemory
 )
 {
 	joinKnowledgeHelper(m_storage, _olderStorage);
@@ -371,18 +381,19 @@ void DataFlowAnalyzer::joinKnowledge(
 }
 
 void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
+	InvertibleMap<YulString, YulString>& _this,
+	PersistentMap<YulString, YulString> const& _older
 )
 {
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	// Since _older is a snapshot of _this.values, only the changed parts are visited.
+	vector<YulString> keysToErase;
+	_this.values.forEachDifference(_older, [&](YulString _key) { keysToErase.emplace_back(_key); });
+	for (YulString const& key: keysToErase)
+		_this.eraseKey(key);
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
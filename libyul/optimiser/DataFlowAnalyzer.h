@@ -29,6 +29,8 @@
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
 
+#include <libsolutil/InvertibleMap.h>
+
 #include <map>
 #include <set>
 
@@ -122,13 +124,13 @@ protected:
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
 	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
+		util::PersistentMap<YulString, YulString> const& _olderStorage,
+		util::PersistentMap<YulString, YulString> const& _olderMemory
 	);
 
 	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
+		util::InvertibleMap<YulString, YulString>& _thisData,
+		util::PersistentMap<YulString, YulString> const& _olderData
 	);
 
 	/// Returns true iff the variable is in scope.
@@ -161,11 +163,14 @@ protected:
 
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
-	/// m_references[a].contains(b) <=> the current expression assigned to a references b
-	std::unordered_map<YulString, std::set<YulString>> m_references;
-
-	std::unordered_map<YulString, YulString> m_storage;
-	std::unordered_map<YulString, YulString> m_memory;
+	/// m_references.forward[a].contains(b) <=> the current expression assigned to a references b
+	/// The inverse relation is used to find the variables affected by a re-assignment.
+	util::InvertibleRelation<YulString> m_references;
+
+	/// Known contents of storage and memory. The inverse maps are used to clear
+	/// all slots that contain a re-assigned variable.
+	util::InvertibleMap<YulString, YulString> m_storage;
+	util::InvertibleMap<YulString, YulString> m_memory;
 
 	KnowledgeBase m_knowledgeBase;
 
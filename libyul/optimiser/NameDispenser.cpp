@@ -46,13 +46,20 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 {
 }
 
+NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> const& _sharedUsedNames, string _suffix):
+	m_dialect(_dialect),
+	m_sharedUsedNames(&_sharedUsedNames),
+	m_suffix(move(_suffix))
+{
+}
+
 YulString NameDispenser::newName(YulString _nameHint)
 {
-	YulString name = _nameHint;
+	YulString name = m_suffix.empty() ? _nameHint : YulString(_nameHint.str() + m_suffix);
 	while (illegalName(name))
 	{
 		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		name = YulString(_nameHint.str() + "_" + to_string(m_counter) + m_suffix);
 	}
 	m_usedNames.emplace(name);
 	return name;
@@ -60,7 +67,10 @@ YulString NameDispenser::newName(YulString _nameHint)
 
 bool NameDispenser::illegalName(YulString _name)
 {
-	return isRestrictedIdentifier(m_dialect, _name) || m_usedNames.count(_name);
+	return
+		isRestrictedIdentifier(m_dialect, _name) ||
+		m_usedNames.count(_name) ||
+		(m_sharedUsedNames && m_sharedUsedNames->count(_name));
 }
 
 void NameDispenser::reset(Block const& _ast)
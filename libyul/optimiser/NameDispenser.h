@@ -25,6 +25,7 @@
 #include <libyul/YulString.h>
 
 #include <set>
+#include <string>
 
 namespace solidity::yul
 {
@@ -43,6 +44,10 @@ public:
 	explicit NameDispenser(Dialect const& _dialect, Block const& _ast, std::set<YulString> _reservedNames = {});
 	/// Initialize the name dispenser with the given used names.
 	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames);
+	/// Initialize a name dispenser that avoids the names in @a _sharedUsedNames, which have to
+	/// outlive the dispenser, and appends @a _suffix to all names it creates. Dispensers
+	/// with different suffixes of the form "_f<number>" never create the same name.
+	NameDispenser(Dialect const& _dialect, std::set<YulString> const& _sharedUsedNames, std::string _suffix);
 
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulString newName(YulString _nameHint);
@@ -51,6 +56,7 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
+	/// @returns the used names, not including the shared used names.
 	std::set<YulString> const& usedNames() { return m_usedNames; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
@@ -64,6 +70,8 @@ private:
 	Dialect const& m_dialect;
 	std::set<YulString> m_usedNames;
 	std::set<YulString> m_reservedNames;
+	std::set<YulString> const* m_sharedUsedNames = nullptr;
+	std::string m_suffix;
 	size_t m_counter = 0;
 };
 
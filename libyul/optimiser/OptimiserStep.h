@@ -19,7 +19,10 @@
 #pragma once
 
 #include <libyul/Exceptions.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
 
+#include <map>
 #include <optional>
 #include <string>
 #include <set>
@@ -29,14 +32,29 @@ namespace solidity::yul
 
 struct Dialect;
 struct Block;
-class YulString;
 class NameDispenser;
 
+/**
+ * Properties of the whole program that are computed before function-local steps
+ * are applied to single functions (see OptimiserSuite::runSequence). Steps use them
+ * instead of the properties of the code they are applied to.
+ */
+struct ProgramFacts
+{
+	std::map<YulString, SideEffects> functionSideEffects;
+	bool containsMSize = false;
+};
+
 struct OptimiserStepContext
 {
 	Dialect const& dialect;
 	NameDispenser& dispenser;
 	std::set<YulString> const& reservedIdentifiers;
+	/// Set if the step is only applied to a part of the program. Functions called from that
+	/// part are only present as stubs with empty bodies, so the step has to use these facts
+	/// instead of computing side effects or the use of msize from the code it is given.
+	/// Only steps listed in OptimiserSuite::functionLocalSteps() are run this way.
+	ProgramFacts const* programFacts = nullptr;
 };
 
 
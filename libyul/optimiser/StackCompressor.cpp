@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/StackCompressor.h>
 
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Rematerialiser.h>
@@ -32,6 +33,10 @@
 
 #include <libyul/AST.h>
 
+#include <boost/range/adaptor/map.hpp>
+
+#include <optional>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -57,7 +62,7 @@ public:
 		for (auto const& codeCost: m_expressionCodeCost)
 		{
 			size_t numRef = m_numReferences[codeCost.first];
-			cand.emplace(make_tuple(codeCost.second * numRef, codeCost.first, m_references[codeCost.first]));
+			cand.emplace(make_tuple(codeCost.second * numRef, codeCost.first, m_references.forward[codeCost.first]));
 		}
 		return cand;
 	}
@@ -151,6 +156,43 @@ void eliminateVariables(
 	UnusedPruner::runUntilStabilised(_dialect, _node, _allowMSizeOptimization);
 }
 
+/// @returns a copy of @a _object where only the code of the functions in @a _functions
+/// is kept (the main block is denoted by the empty name). The bodies of all other functions
+/// are removed, so that the object can be checked for compilability more quickly.
+/// This works because the stack layout inside one function does not depend on the code
+/// of other functions.
+Object reducedObject(Object const& _object, set<YulString> const& _functions)
+{
+	Object reduced;
+	reduced.name = _object.name;
+	reduced.subObjects = _object.subObjects;
+	reduced.subIndexByName = _object.subIndexByName;
+	reduced.code = make_shared<Block>();
+	reduced.code->location = _object.code->location;
+
+	Block const& mainBlock = std::get<Block>(_object.code->statements.at(0));
+	if (_functions.count({}))
+		reduced.code->statements.emplace_back(ASTCopier{}.translate(_object.code->statements.at(0)));
+	else
+		reduced.code->statements.emplace_back(Block{mainBlock.location, {}});
+
+	for (size_t i = 1; i < _object.code->statements.size(); ++i)
+	{
+		auto const& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
+		if (_functions.count(fun.name))
+			reduced.code->statements.emplace_back(ASTCopier{}.translate(_object.code->statements[i]));
+		else
+			reduced.code->statements.emplace_back(FunctionDefinition{
+				fun.location,
+				fun.name,
+				fun.parameters,
+				fun.returnVariables,
+				Block{fun.body.location, {}}
+			});
+	}
+	return reduced;
+}
+
 }
 
 bool StackCompressor::run(
@@ -166,11 +208,20 @@ bool StackCompressor::run(
 		"Need to run the function grouper before the stack compressor."
 	);
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
+	// Functions modified in the last iteration. All other functions are known to be compilable.
+	optional<set<YulString>> modifiedFunctions;
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+		map<YulString, int> stackSurplus = CompilabilityChecker(
+			_dialect,
+			modifiedFunctions ? reducedObject(_object, *modifiedFunctions) : _object,
+			_optimizeStackAllocation
+		).stackDeficit;
 		if (stackSurplus.empty())
 			return true;
+		modifiedFunctions = set<YulString>{};
+		for (auto const& name: stackSurplus | boost::adaptors::map_keys)
+			modifiedFunctions->insert(name);
 
 		if (stackSurplus.count(YulString{}))
 		{
@@ -24,6 +24,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
@@ -71,11 +72,17 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 #include <libyul/CompilabilityChecker.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -86,7 +93,9 @@ void OptimiserSuite::run(
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	bool _optimizeFunctionsSeparately,
+	bool _concurrent
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -99,7 +108,14 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(
+		_dialect,
+		reservedIdentifiers,
+		Debug::None,
+		ast,
+		_optimizeFunctionsSeparately,
+		_concurrent
+	);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -152,6 +168,38 @@ void OptimiserSuite::run(
 namespace
 {
 
+struct StatisticsCollector
+{
+	static StatisticsCollector& instance()
+	{
+		static StatisticsCollector collector;
+		return collector;
+	}
+
+	void record(string const& _step, bool _changed, chrono::nanoseconds _time)
+	{
+		if (!enabled)
+			return;
+		lock_guard<mutex> lock(statisticsMutex);
+		OptimiserSuite::StepStatistics& step = statistics[_step];
+		++step.runs;
+		if (_changed)
+			++step.changes;
+		step.time += _time;
+	}
+
+	void recordSkip(string const& _step)
+	{
+		if (!enabled)
+			return;
+		lock_guard<mutex> lock(statisticsMutex);
+		++statistics[_step].skips;
+	}
+
+	atomic<bool> enabled{false};
+	mutex statisticsMutex;
+	map<string, OptimiserSuite::StepStatistics> statistics;
+};
 
 template <class... Step>
 map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
@@ -210,6 +258,54 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 	return instance;
 }
 
+void OptimiserSuite::enableStatistics()
+{
+	StatisticsCollector::instance().enabled = true;
+}
+
+map<string, OptimiserSuite::StepStatistics> OptimiserSuite::statistics()
+{
+	StatisticsCollector& collector = StatisticsCollector::instance();
+	lock_guard<mutex> lock(collector.statisticsMutex);
+	return collector.statistics;
+}
+
+set<string> const& OptimiserSuite::functionLocalSteps()
+{
+	// Steps that add, remove or rename functions or that look at the calls of a function
+	// are not function-local. ReasoningBasedSimplifier is not listed because the SMT
+	// solver interfaces are not known to be thread-safe.
+	// The steps only see stubs of the functions they call. CommonSubexpressionEliminator,
+	// LoadResolver and LoopInvariantCodeMotion take the side effects of functions and the use
+	// of msize from OptimiserStepContext::programFacts. The other steps treat calls to
+	// user-defined functions as having arbitrary side effects. A step that computes such
+	// properties from the code (SideEffectsPropagator, MSizeFinder, CallGraphGenerator)
+	// without using the program facts must not be added here.
+	static set<string> const steps{
+		CommonSubexpressionEliminator::name,
+		ConditionalSimplifier::name,
+		ConditionalUnsimplifier::name,
+		ControlFlowSimplifier::name,
+		DeadCodeEliminator::name,
+		ExpressionJoiner::name,
+		ExpressionSimplifier::name,
+		ExpressionSplitter::name,
+		ForLoopConditionIntoBody::name,
+		ForLoopConditionOutOfBody::name,
+		ForLoopInitRewriter::name,
+		LiteralRematerialiser::name,
+		LoadResolver::name,
+		LoopInvariantCodeMotion::name,
+		RedundantAssignEliminator::name,
+		Rematerialiser::name,
+		SSAReverser::name,
+		SSATransform::name,
+		StructuralSimplifier::name,
+		VarDeclInitializer::name,
+	};
+	return steps;
+}
+
 map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 {
 	static map<string, char> lookupTable{
@@ -337,15 +433,195 @@ void OptimiserSuite::runSequence(string const& _stepAbbreviations, Block& _ast)
 }
 
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
+{
+	if (!m_optimizeFunctionsSeparately)
+	{
+		runSteps(_steps, _ast);
+		return;
+	}
+
+	// Split the sequence into maximal parts that consist either only of
+	// function-local steps or only of other steps.
+	for (auto begin = _steps.begin(); begin != _steps.end();)
+	{
+		bool functionLocal = functionLocalSteps().count(*begin);
+		auto end = find_if(begin, _steps.end(), [&](string const& _step) {
+			return functionLocalSteps().count(_step) != functionLocal;
+		});
+		if (functionLocal)
+			runStepsOnFunctions(vector<string>(begin, end), _ast);
+		else
+			runSteps(vector<string>(begin, end), _ast);
+		begin = end;
+	}
+}
+
+void OptimiserSuite::runStepsOnFunctions(vector<string> const& _steps, Block& _ast)
+{
+	for (string const& step: _steps)
+		yulAssert(functionLocalSteps().count(step), "Step " + step + " is not known to be safe on single functions.");
+
+	// Only works on code where all functions have been moved to the top level by FunctionHoister.
+	map<YulString, FunctionDefinition const*> functions;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			functions[function->name] = function;
+	if (functions.empty())
+	{
+		runSteps(_steps, _ast);
+		return;
+	}
+
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	ProgramFacts facts{
+		SideEffectsPropagator::sideEffects(m_context.dialect, callGraph),
+		MSizeFinder::containsMSize(m_context.dialect, _ast)
+	};
+	if (
+		facts.containsMSize != m_programFacts.containsMSize ||
+		facts.functionSideEffects != m_programFacts.functionSideEffects
+	)
+	{
+		// Steps can find more to do with the new facts.
+		m_unchangedFunctions.clear();
+		m_programFacts = move(facts);
+	}
+	set<YulString> const usedNames = m_dispenser.usedNames();
+
+	// The first part consists of the statements outside of functions, the other parts are the functions.
+	// Every part is optimised inside a block that also contains the signatures of the
+	// functions it calls, so that the types of the calls are known.
+	vector<Block> parts(functions.size() + 1);
+	vector<YulString> partNames{YulString{}};
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			partNames.emplace_back(function->name);
+	for (size_t i = 0; i < parts.size(); ++i)
+		if (auto const* callees = util::valueOrNullptr(callGraph.functionCalls, partNames[i]))
+			for (YulString callee: *callees)
+				if (callee != partNames[i] && functions.count(callee))
+				{
+					FunctionDefinition const& function = *functions.at(callee);
+					parts[i].statements.emplace_back(FunctionDefinition{
+						function.location,
+						function.name,
+						function.parameters,
+						function.returnVariables,
+						{}
+					});
+				}
+	functions.clear();
+
+	size_t functionIndex = 1;
+	vector<Statement> mainStatements;
+	for (Statement& statement: _ast.statements)
+		if (holds_alternative<FunctionDefinition>(statement))
+		{
+			vector<Statement>& partStatements = parts[functionIndex++].statements;
+			partStatements.emplace(partStatements.begin(), move(statement));
+		}
+		else
+			mainStatements.emplace_back(move(statement));
+	parts[0].statements.insert(
+		parts[0].statements.begin(),
+		make_move_iterator(mainStatements.begin()),
+		make_move_iterator(mainStatements.end())
+	);
+
+	vector<unique_ptr<NameDispenser>> dispensers(parts.size());
+	// Hashes of unchanged parts found while optimising, by part. Only merged into
+	// m_unchangedFunctions at the end, which is read concurrently until then.
+	vector<map<string, set<uint64_t>>> unchangedParts(parts.size());
+	atomic<size_t> nextPart{0};
+	auto optimiseParts = [&]()
+	{
+		for (size_t i = nextPart++; i < parts.size(); i = nextPart++)
+		{
+			// The suffix only depends on the position of the part, which keeps the names deterministic.
+			dispensers[i] = make_unique<NameDispenser>(m_context.dialect, usedNames, "_f" + to_string(i));
+			OptimiserStepContext context{m_context.dialect, *dispensers[i], m_context.reservedIdentifiers, &m_programFacts};
+			uint64_t hash = ASTHasher::run(parts[i]);
+			for (string const& step: _steps)
+			{
+				auto const* unchangedFunctions = util::valueOrNullptr(m_unchangedFunctions, step);
+				if ((unchangedFunctions && unchangedFunctions->count(hash)) || unchangedParts[i][step].count(hash))
+				{
+					StatisticsCollector::instance().recordSkip(step);
+					continue;
+				}
+				auto start = chrono::steady_clock::now();
+				allSteps().at(step)->run(context, parts[i]);
+				auto time = chrono::steady_clock::now() - start;
+				uint64_t newHash = ASTHasher::run(parts[i]);
+				StatisticsCollector::instance().record(step, newHash != hash, time);
+				if (newHash == hash)
+					unchangedParts[i][step].insert(hash);
+				hash = newHash;
+			}
+		}
+	};
+	// Every worker takes the next part until all are done. This thread helps as well.
+	vector<future<void>> workers;
+	if (m_concurrent)
+		for (size_t i = 1; i < min(util::ThreadPool::shared().workerCount() + 1, parts.size()); ++i)
+			workers.emplace_back(util::ThreadPool::shared().submit(optimiseParts));
+	// The workers refer to the locals of this function, so all of them have to be
+	// finished before an exception is rethrown.
+	auto waitForWorkers = [&]() { for (auto& worker: workers) worker.wait(); };
+	try
+	{
+		optimiseParts();
+	}
+	catch (...)
+	{
+		waitForWorkers();
+		throw;
+	}
+	waitForWorkers();
+	for (auto& worker: workers)
+		worker.get();
+
+	// The statements outside of functions are put before all functions. The signatures are
+	// the only function definitions in the first part.
+	_ast.statements.clear();
+	for (Statement& statement: parts[0].statements)
+		if (!holds_alternative<FunctionDefinition>(statement))
+			_ast.statements.emplace_back(move(statement));
+	for (size_t i = 1; i < parts.size(); ++i)
+	{
+		yulAssert(holds_alternative<FunctionDefinition>(parts[i].statements.front()), "");
+		_ast.statements.emplace_back(move(parts[i].statements.front()));
+	}
+	for (auto const& dispenser: dispensers)
+		for (YulString name: dispenser->usedNames())
+			m_dispenser.markUsed(name);
+	for (auto const& unchanged: unchangedParts)
+		for (auto const& [step, hashes]: unchanged)
+			m_unchangedFunctions[step] += hashes;
+}
+
+void OptimiserSuite::runSteps(std::vector<string> const& _steps, Block& _ast)
 {
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	// Whole programs hardly ever stay unchanged, so hashing them is only
+	// worth it to collect statistics.
+	bool const collectStatistics = StatisticsCollector::instance().enabled;
+	uint64_t hash = collectStatistics ? ASTHasher::run(_ast) : 0;
 	for (string const& step: _steps)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
+		auto start = chrono::steady_clock::now();
 		allSteps().at(step)->run(m_context, _ast);
+		if (collectStatistics)
+		{
+			auto time = chrono::steady_clock::now() - start;
+			uint64_t newHash = ASTHasher::run(_ast);
+			StatisticsCollector::instance().record(step, newHash != hash, time);
+			hash = newHash;
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
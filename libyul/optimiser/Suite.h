@@ -27,6 +27,8 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <chrono>
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
@@ -58,15 +60,36 @@ public:
 		PrintStep,
 		PrintChanges
 	};
+
+	/// Statistics about the executions of one optimiser step.
+	struct StepStatistics
+	{
+		/// Number of times the step was run.
+		size_t runs = 0;
+		/// Number of runs that changed the code.
+		size_t changes = 0;
+		/// Number of times the step was not run because it was known not to change the code.
+		/// Only happens if functions are optimised separately.
+		size_t skips = 0;
+		std::chrono::nanoseconds time{0};
+	};
+
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		bool _optimizeFunctionsSeparately = false,
+		bool _concurrent = false
 	);
 
+	/// Starts collecting statistics about the steps run by all suites in this process.
+	static void enableStatistics();
+	/// @returns the statistics collected since enableStatistics was called, by step name.
+	static std::map<std::string, StepStatistics> statistics();
+
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
 	/// @throw OptimizerException if the sequence is invalid
 	static void validateSequence(std::string const& _stepAbbreviations);
@@ -80,6 +103,11 @@ public:
 	);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
+	/// @returns the names of the steps that only need the code of a single function
+	/// and properties of the whole program that are captured by ProgramFacts.
+	/// These steps have to be safe on code where the called functions are stubs,
+	/// i.e. they must not look into the bodies of other functions.
+	static std::set<std::string> const& functionLocalSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
@@ -88,16 +116,38 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		bool _optimizeFunctionsSeparately = false,
+		bool _concurrent = false
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
 		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_debug(_debug),
+		m_optimizeFunctionsSeparately(_optimizeFunctionsSeparately),
+		m_concurrent(_concurrent)
 	{}
 
+	void runSteps(std::vector<std::string> const& _steps, Block& _ast);
+	/// Applies the function-local @a _steps to the code outside of functions and to each
+	/// function separately, concurrently if m_concurrent is set. Requires all functions to be
+	/// at the top level.
+	/// Moves the code outside of functions in front of the functions.
+	void runStepsOnFunctions(std::vector<std::string> const& _steps, Block& _ast);
+
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Hashes (see ASTHasher) of the parts used by runStepsOnFunctions that a step is known
+	/// not to change, by step name. Steps are deterministic, so they do not have to be run
+	/// on such parts again. Only valid as long as m_programFacts stays the same.
+	std::map<std::string, std::set<uint64_t>> m_unchangedFunctions;
+	ProgramFacts m_programFacts;
+	/// If true, function-local steps are applied to each function separately. The names
+	/// of new variables differ from the ones created when optimising the whole program.
+	bool m_optimizeFunctionsSeparately = false;
+	/// If true, the functions are optimised separately in the threads of the shared thread pool.
+	/// This does not change the result.
+	bool m_concurrent = false;
 };
 
 }
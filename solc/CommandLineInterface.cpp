@@ -31,6 +31,7 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -73,6 +74,7 @@
 
 #include <string>
 #include <iostream>
+#include <iomanip>
 #include <fstream>
 
 #if !defined(STDERR_FILENO)
@@ -116,6 +118,7 @@ static string const g_stdinFileNameStr = "<stdin>";
 static string const g_strAbi = "abi";
 static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
 static string const g_strAssemble = "assemble";
@@ -151,6 +154,7 @@ static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerSolverStrategy = "model-checker-solver-strategy";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNatspecDev = "devdoc";
@@ -161,7 +165,10 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strOptimizeConcurrently = "optimize-concurrently";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerStats = "yul-optimizer-stats";
+static string const g_strYulOptimizeFunctionsSeparately = "yul-optimize-functions-separately";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
@@ -184,6 +191,7 @@ static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
+static string const g_strStandardJSONStreaming = "standard-json-streaming";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
 static string const g_strPrettyJson = "pretty-json";
@@ -197,6 +205,7 @@ static string const g_argAbi = g_strAbi;
 static string const g_argPrettyJson = g_strPrettyJson;
 static string const g_argAllowPaths = g_strAllowPaths;
 static string const g_argBasePath = g_strBasePath;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
@@ -222,6 +231,7 @@ static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataHash = g_strMetadataHash;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
+static string const g_argModelCheckerSolverStrategy = g_strModelCheckerSolverStrategy;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
 static string const g_argNatspecDev = g_strNatspecDev;
@@ -331,6 +341,21 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 namespace
 {
 
+/// @returns true if any of the requested outputs needs the EVM assembly,
+/// which is not available for contracts taken from the compilation cache.
+static bool needsEvmAssembly(po::variables_map const& _args)
+{
+	if (_args.count(g_argAsm) || _args.count(g_argAsmJson) || _args.count(g_argGas))
+		return true;
+	if (_args.count(g_argCombinedJson))
+	{
+		vector<string> requests;
+		boost::split(requests, _args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
+		return contains(requests, g_strAsm);
+	}
+	return false;
+}
+
 bool checkMutuallyExclusive(boost::program_options::variables_map const& args, std::string const& _optionA, std::string const& _optionB)
 {
 	if (args.count(_optionA) && args.count(_optionB))
@@ -857,6 +882,14 @@ General Information)").c_str(),
 			g_strOverwrite.c_str(),
 			"Overwrite existing files (used together with -o)."
 		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Look up the bytecode of contracts in the given directory and store it there "
+			"after compilation, so that it can be reused by later invocations. "
+			"Not used for the assembly and gas estimation outputs. "
+			"The number of cache hits, misses and stores is printed to stderr."
+		)
 		(
 			g_strEVMVersion.c_str(),
 			po::value<string>()->value_name("version"),
@@ -887,6 +920,12 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strStandardJSONStreaming.c_str(),
+			("Used together with --" + g_argStandardJSON + ": Write the output of each contract as soon as "
+			"it is computed instead of building the whole output in memory first. Internal errors while "
+			"computing the output of a contract are reported as errors and the contract is left out.").c_str()
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -1040,6 +1079,24 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulOptimizeFunctionsSeparately.c_str(),
+			"Apply the Yul optimizer steps that only need the code of a single function to every function separately. "
+			"A step is not run again on a function it did not change before. "
+			"This changes the names of the variables introduced by the optimizer."
+		)
+		(
+			g_strOptimizeConcurrently.c_str(),
+			"Run independent parts of the optimizer in multiple threads. This does not change the output. "
+			"Has no effect if the compiler was built without thread support."
+		)
+		(
+			g_strYulOptimizerStats.c_str(),
+			(
+				"Print how often each Yul optimizer step was run, how often it changed the code and how long it took to stderr. "
+				"Also prints how often a step was skipped, which only happens with --" + g_strYulOptimizeFunctionsSeparately + "."
+			).c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1064,6 +1121,13 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerSolverStrategy.c_str(),
+			po::value<string>()->value_name("sequential,parallel,race")->default_value("sequential"),
+			"Select how the BMC engine queries the available solvers. "
+			"\"parallel\" runs them concurrently and still cross-checks their answers, "
+			"\"race\" uses the first answer without waiting for the other solvers."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1254,6 +1318,12 @@ bool CommandLineInterface::processInput()
 			m_stopAfter = CompilerStack::State::Parsed;
 	}
 
+	if (m_args.count(g_strYulOptimizerStats))
+		yul::OptimiserSuite::enableStatistics();
+
+	if (m_args.count(g_argCacheDir))
+		m_compilationCache = make_shared<CompilationCache>(m_args[g_argCacheDir].as<string>());
+
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
 		g_argLink,
@@ -1269,6 +1339,12 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_strStandardJSONStreaming) && !m_args.count(g_argStandardJSON))
+	{
+		serr() << "--" << g_strStandardJSONStreaming << " is only valid together with --" << g_argStandardJSON << "." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1297,8 +1373,14 @@ bool CommandLineInterface::processInput()
 				return false;
 			}
 		}
-		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
+		StandardCompiler compiler(fileReader, m_compilationCache);
+		if (m_args.count(g_strStandardJSONStreaming))
+		{
+			compiler.compile(input, sout());
+			sout() << endl;
+		}
+		else
+			sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
 
@@ -1374,6 +1456,11 @@ bool CommandLineInterface::processInput()
 
 			yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
+		if (m_args.count(g_strYulOptimizeFunctionsSeparately) && !optimize)
+		{
+			serr() << "--" << g_strYulOptimizeFunctionsSeparately << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
 
 		if (m_args.count(g_argMachine))
 		{
@@ -1489,6 +1576,18 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_argModelCheckerSolverStrategy))
+	{
+		string strategyStr = m_args[g_argModelCheckerSolverStrategy].as<string>();
+		optional<smtutil::SMTPortfolioStrategy> strategy = ModelCheckerSettings::solverStrategyFromString(strategyStr);
+		if (!strategy)
+		{
+			serr() << "Invalid option for --" << g_argModelCheckerSolverStrategy << ": " << strategyStr << endl;
+			return false;
+		}
+		m_modelCheckerSettings.solverStrategy = *strategy;
+	}
+
 	m_compiler = make_unique<CompilerStack>(fileReader);
 
 	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
@@ -1499,8 +1598,14 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argMetadataHash))
 			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		if (
+			m_args.count(g_argModelCheckerEngine) ||
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerSolverStrategy)
+		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
+		if (m_compilationCache && !needsEvmAssembly(m_args))
+			m_compiler->setCompilationCache(m_compilationCache);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
 
@@ -1539,7 +1644,17 @@ bool CommandLineInterface::processInput()
 
 			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
+		if (m_args.count(g_strYulOptimizeFunctionsSeparately))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_strYulOptimizeFunctionsSeparately << " is invalid if Yul optimizer is disabled" << endl;
+				return false;
+			}
+			settings.optimizeYulFunctionsSeparately = true;
+		}
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		settings.concurrent = m_args.count(g_strOptimizeConcurrently);
 		m_compiler->setOptimiserSettings(settings);
 
 		if (m_args.count(g_argImportAst))
@@ -1710,19 +1825,29 @@ void CommandLineInterface::handleCombinedJSON()
 			output[g_strSourceList].append(source);
 	}
 
+	bool const prettyJson = m_args.count(g_argPrettyJson);
+	ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
 	if (requests.count(g_strAst))
 	{
 		output[g_strSources] = Json::Value(Json::objectValue);
 		for (auto const& sourceCode: m_sourceCodes)
 		{
-			ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
+			ASTNode const& ast = m_compiler->ast(sourceCode.first);
 			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			// The compact output is written without building the json trees of the ASTs.
+			output[g_strSources][sourceCode.first]["AST"] = prettyJson ? converter.toJson(ast) : converter.placeholder(ast);
 		}
 	}
 
-	string json = m_args.count(g_argPrettyJson) ? jsonPrettyPrint(removeNullMembers(std::move(output))) :
-		jsonCompactPrint(removeNullMembers(std::move(output)));
+	string json;
+	if (prettyJson)
+		json = jsonPrettyPrint(removeNullMembers(std::move(output)));
+	else
+	{
+		ostringstream stream;
+		converter.printCompact(stream, removeNullMembers(std::move(output)));
+		json = stream.str();
+	}
 
 	if (m_args.count(g_argOutputDir))
 		createJson("combined", json);
@@ -1764,14 +1889,45 @@ void CommandLineInterface::handleAst()
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
-		// Already done in "processInput" phase.
-		return true;
-	else if (m_onlyLink)
-		writeLinkedFiles();
-	else
-		outputCompilationResults();
-	return !m_error;
+	bool success = true;
+	// Standard JSON and assembly are already done in "processInput" phase.
+	if (!m_args.count(g_argStandardJSON) && !m_onlyAssemble)
+	{
+		if (m_onlyLink)
+			writeLinkedFiles();
+		else
+			outputCompilationResults();
+		success = !m_error;
+	}
+
+	if (m_args.count(g_strYulOptimizerStats))
+		outputYulOptimizerStatistics();
+	if (m_compilationCache && !m_onlyAssemble && !m_onlyLink)
+		outputCompilationCacheStatistics();
+	return success;
+}
+
+void CommandLineInterface::outputYulOptimizerStatistics()
+{
+	serr() << endl << "Yul optimizer statistics:" << endl;
+	serr() << setw(36) << left << "step" << right << setw(8) << "runs" << setw(9) << "changes" << setw(7) << "skips" << setw(11) << "time [ms]" << endl;
+	for (auto const& [step, statistics]: yul::OptimiserSuite::statistics())
+		serr() <<
+			setw(36) << left << step << right <<
+			setw(8) << statistics.runs <<
+			setw(9) << statistics.changes <<
+			setw(7) << statistics.skips <<
+			setw(11) << chrono::duration_cast<chrono::milliseconds>(statistics.time).count() <<
+			endl;
+}
+
+void CommandLineInterface::outputCompilationCacheStatistics()
+{
+	CompilationCache::Statistics statistics = m_compilationCache->statistics();
+	serr() << endl << "Compilation cache statistics:" << endl;
+	serr() << "hits: " << statistics.hits << endl;
+	serr() << "misses: " << statistics.misses << endl;
+	serr() << "stores: " << statistics.stores << endl;
 }
 
 bool CommandLineInterface::link()
@@ -1884,6 +2040,8 @@ bool CommandLineInterface::assemble(
 		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
 		if (_yulOptimiserSteps.has_value())
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+		settings.optimizeYulFunctionsSeparately = m_args.count(g_strYulOptimizeFunctionsSeparately);
+		settings.concurrent = m_args.count(g_strOptimizeConcurrently);
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
 		try
@@ -65,6 +65,8 @@ private:
 	);
 
 	void outputCompilationResults();
+	void outputYulOptimizerStatistics();
+	void outputCompilationCacheStatistics();
 
 	void handleCombinedJSON();
 	void handleAst();
@@ -126,6 +128,8 @@ private:
 	std::map<std::string, util::h160> m_libraries;
 	/// Solidity compiler stack
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
+	/// Cache of compiled contracts, if --cache-dir is given. Shared by all compilations of the run.
+	std::shared_ptr<frontend::CompilationCache> m_compilationCache;
 	CompilerStack::State m_stopAfter = CompilerStack::State::CompilationSuccessful;
 	/// EVM version to use
 	langutil::EVMVersion m_evmVersion;
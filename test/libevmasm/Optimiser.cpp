@@ -1266,6 +1266,68 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_subassemblies)
+{
+	// Optimising independent sub-assemblies concurrently has to produce the same bytecode
+	// as optimising them one after the other.
+	auto createAssembly = []()
+	{
+		auto main = make_shared<Assembly>();
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			AssemblyPointer sub = make_shared<Assembly>();
+			sub->append(u256(i));
+			auto t1 = sub->newTag();
+			sub->append(t1);
+			sub->append(u256(u256(0x1234) << (8 * i)));
+			sub->append(Instruction::JUMP);
+			auto t2 = sub->newTag();
+			sub->append(t2); // Identical to t1, will be unified
+			sub->append(u256(u256(0x1234) << (8 * i)));
+			sub->append(Instruction::JUMP);
+			auto t3 = sub->newTag();
+			sub->append(t3);
+			sub->append(u256(i + 1));
+			sub->append(u256(i + 2));
+			sub->append(Instruction::ADD);
+			sub->append(u256(0));
+			sub->append(Instruction::MSTORE);
+			sub->append(u256(~u256(0) >> (8 * i)));
+			sub->append(u256(32));
+			sub->append(Instruction::MSTORE);
+			sub->append(t3.pushTag());
+			sub->append(Instruction::JUMP);
+
+			size_t subId = static_cast<size_t>(main->appendSubroutine(sub).data());
+			main->append(t1.toSubAssemblyTag(subId).pushTag());
+			main->append(t2.toSubAssemblyTag(subId).pushTag());
+			main->append(Instruction::POP);
+			main->append(Instruction::POP);
+		}
+		return main;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runInliner = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	settings.expectedExecutionsPerDeployment = 200;
+
+	auto sequential = createAssembly();
+	sequential->optimise(settings);
+	settings.concurrent = true;
+	auto concurrent = createAssembly();
+	concurrent->optimise(settings);
+
+	BOOST_CHECK_EQUAL(concurrent->assemble().toHex(), sequential->assemble().toHex());
+	BOOST_CHECK_EQUAL(concurrent->assemblyString(), sequential->assemblyString());
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
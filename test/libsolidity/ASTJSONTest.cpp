@@ -20,6 +20,7 @@
 #include <test/libsolidity/ASTJSONTest.h>
 #include <test/Common.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/JSON.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -208,6 +209,26 @@ bool ASTJSONTest::runTest(
 		ostringstream result;
 		ASTJsonConverter(_compiler.state(), _sourceIndices).print(result, _compiler.ast(m_sources[i].first));
 		_result += result.str();
+
+		// The compact output is written node by node and has to match the converted tree.
+		ostringstream compactResult;
+		ASTJsonConverter(_compiler.state(), _sourceIndices).printCompact(compactResult, _compiler.ast(m_sources[i].first));
+		string expectedCompactResult = jsonCompactPrint(
+			ASTJsonConverter(_compiler.state(), _sourceIndices).toJson(_compiler.ast(m_sources[i].first))
+		);
+		if (compactResult.str() != expectedCompactResult)
+		{
+			AnsiColorized(_stream, _formatted, {BOLD, RED}) <<
+				_linePrefix <<
+				"Compact output of " << m_sources[i].first <<
+				(!_variation.empty() ? " (" + _variation + ")" : "") <<
+				" differs from the converted AST:" <<
+				endl;
+			_stream << _linePrefix << "  " << compactResult.str() << endl;
+			_stream << _linePrefix << "  " << expectedCompactResult << endl;
+			return false;
+		}
+
 		if (i != m_sources.size() - 1)
 			_result += ",";
 		_result += "\n";
@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the compilation cache.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libsolutil/JSON.h>
+
+#include <test/Common.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+class TemporaryCacheDirectory
+{
+public:
+	TemporaryCacheDirectory():
+		m_path(fs::temp_directory_path() / fs::unique_path("solidity-cache-%%%%-%%%%-%%%%"))
+	{}
+	~TemporaryCacheDirectory()
+	{
+		boost::system::error_code error;
+		fs::remove_all(m_path, error);
+	}
+	fs::path const& path() const { return m_path; }
+
+private:
+	fs::path m_path;
+};
+
+char const* sourceA = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	library L { function f(uint x) public pure returns (uint) { return x + 1; } }
+	contract A { uint immutable x = 7; function f() public view returns (uint) { return L.f(x); } }
+)";
+
+char const* sourceB = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	import "A.sol";
+	contract B { function g() public returns (A) { return new A(); } }
+)";
+
+/// Compiles the sources using @a _cache and @returns the bytecode, the immutable references,
+/// the source mappings and the generated sources of each contract in textual form.
+/// Only one CompilerStack can exist at a time, so the results are not compared directly.
+map<string, string> compile(shared_ptr<CompilationCache> _cache, string const& _sourceB = sourceB)
+{
+	CompilerStack stack;
+	stack.setSources({{"A.sol", sourceA}, {"B.sol", _sourceB}});
+	stack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	stack.setOptimiserSettings(OptimiserSettings::standard());
+	stack.setCompilationCache(move(_cache));
+	BOOST_REQUIRE_MESSAGE(stack.compile(), "Compiling contracts failed");
+
+	map<string, string> result;
+	for (string const& contract: stack.contractNames())
+	{
+		string& output = result[contract];
+		output += stack.object(contract).toHex() + "\n";
+		output += stack.runtimeObject(contract).toHex() + "\n";
+		for (auto const& [hash, references]: stack.runtimeObject(contract).immutableReferences)
+		{
+			output += hash.str() + " " + references.first + ":";
+			for (size_t offset: references.second)
+				output += " " + to_string(offset);
+			output += "\n";
+		}
+		output += *stack.sourceMapping(contract) + "\n";
+		output += *stack.runtimeSourceMapping(contract) + "\n";
+		output += util::jsonCompactPrint(stack.generatedSources(contract)) + "\n";
+		output += util::jsonCompactPrint(stack.generatedSources(contract, true)) + "\n";
+	}
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilationCacheTest)
+
+BOOST_AUTO_TEST_CASE(cached_contracts_are_identical)
+{
+	TemporaryCacheDirectory directory;
+
+	map<string, string> reference = compile(nullptr);
+
+	auto firstCache = make_shared<CompilationCache>(directory.path());
+	BOOST_CHECK(compile(firstCache) == reference);
+	BOOST_CHECK_EQUAL(firstCache->statistics().hits, 0);
+	BOOST_CHECK_EQUAL(firstCache->statistics().misses, 3);
+	BOOST_CHECK_EQUAL(firstCache->statistics().stores, 3);
+
+	// A new cache object only shares the directory.
+	auto secondCache = make_shared<CompilationCache>(directory.path());
+	map<string, string> second = compile(secondCache);
+	BOOST_CHECK_EQUAL(secondCache->statistics().hits, 3);
+	BOOST_CHECK_EQUAL(secondCache->statistics().misses, 0);
+	BOOST_CHECK_EQUAL(secondCache->statistics().stores, 0);
+
+	BOOST_REQUIRE_EQUAL(second.size(), reference.size());
+	for (auto const& [contract, output]: reference)
+		BOOST_CHECK_EQUAL(second[contract], output);
+}
+
+BOOST_AUTO_TEST_CASE(changed_sources_are_recompiled)
+{
+	TemporaryCacheDirectory directory;
+	compile(make_shared<CompilationCache>(directory.path()));
+
+	// Only B depends on the changed source. A is compiled again because the code of
+	// B contains it, but it is not stored a second time.
+	auto cache = make_shared<CompilationCache>(directory.path());
+	map<string, string> second = compile(cache, string(sourceB) + "\n");
+	BOOST_CHECK_EQUAL(cache->statistics().hits, 2);
+	BOOST_CHECK_EQUAL(cache->statistics().misses, 1);
+	BOOST_CHECK_EQUAL(cache->statistics().stores, 1);
+
+	map<string, string> reference = compile(nullptr, string(sourceB) + "\n");
+	BOOST_REQUIRE_EQUAL(second.size(), reference.size());
+	for (auto const& [contract, output]: reference)
+		BOOST_CHECK_EQUAL(second[contract], output);
+}
+
+BOOST_AUTO_TEST_CASE(corrupt_entries_are_ignored)
+{
+	TemporaryCacheDirectory directory;
+	auto cache = make_shared<CompilationCache>(directory.path());
+
+	map<string, string> first = compile(cache);
+	for (auto const& entry: fs::directory_iterator(directory.path()))
+		fs::resize_file(entry.path(), fs::file_size(entry.path()) / 2);
+
+	BOOST_CHECK(compile(cache) == first);
+	BOOST_CHECK_EQUAL(cache->statistics().hits, 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_entries_are_replaced)
+{
+	TemporaryCacheDirectory directory;
+	map<string, string> reference = compile(make_shared<CompilationCache>(directory.path()));
+
+	vector<fs::path> entries;
+	for (auto const& entry: fs::directory_iterator(directory.path()))
+		entries.emplace_back(entry.path());
+	BOOST_REQUIRE_EQUAL(entries.size(), 3);
+	// An empty file, a file that is not JSON and an entry of a different format.
+	vector<string> contents{"", "not json {", R"({"version":1,"key":"00","object":{}})"};
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		ofstream file(entries[i].string(), ios::binary | ios::trunc);
+		file << contents[i];
+	}
+
+	auto cache = make_shared<CompilationCache>(directory.path());
+	BOOST_CHECK(compile(cache) == reference);
+	BOOST_CHECK_EQUAL(cache->statistics().hits, 0);
+	BOOST_CHECK_EQUAL(cache->statistics().misses, 3);
+	BOOST_CHECK_EQUAL(cache->statistics().stores, 3);
+
+	auto secondCache = make_shared<CompilationCache>(directory.path());
+	BOOST_CHECK(compile(secondCache) == reference);
+	BOOST_CHECK_EQUAL(secondCache->statistics().hits, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
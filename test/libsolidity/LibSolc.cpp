@@ -179,6 +179,44 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(streaming_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} } contract B { function g() public {} }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["*"], "": ["ast"] } }
+		}
+	}
+	)";
+
+	char* outputPtr = solidity_compile(input, nullptr, nullptr);
+	string output(outputPtr);
+	solidity_free(outputPtr);
+	solidity_reset();
+
+	string streamedOutput;
+	CStyleWriteOutputCallback callback{
+		[](void* _context, char const* _data, size_t _length)
+		{
+			static_cast<string*>(_context)->append(_data, _length);
+		}
+	};
+	solidity_compile_streaming(input, nullptr, nullptr, callback, &streamedOutput);
+	solidity_reset();
+
+	BOOST_CHECK_EQUAL(streamedOutput, output);
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(streamedOutput, result));
+	BOOST_CHECK(result["contracts"]["fileA"].isMember("A"));
+	BOOST_CHECK(result["contracts"]["fileA"].isMember("B"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -242,6 +242,40 @@ BOOST_AUTO_TEST_CASE(encoded_sizes)
 	BOOST_CHECK_EQUAL(twoDimArray.calldataEncodedSize(false), 9 * 3 * 32);
 }
 
+BOOST_AUTO_TEST_CASE(identical_types_are_shared)
+{
+	TypeProvider::reset();
+	Type const* uint256 = TypeProvider::uint256();
+
+	MappingType const* mapping = TypeProvider::mapping(uint256, TypeProvider::boolean());
+	BOOST_CHECK(mapping != TypeProvider::mapping(TypeProvider::boolean(), uint256));
+	ArrayType const* array = TypeProvider::array(DataLocation::Memory, uint256, 3);
+	BOOST_CHECK(array != TypeProvider::array(DataLocation::Memory, uint256, 4));
+	BOOST_CHECK(array != TypeProvider::array(DataLocation::Storage, uint256, 3));
+	Type const* storagePointer = TypeProvider::withLocation(array, DataLocation::Storage, true);
+	BOOST_CHECK(storagePointer != TypeProvider::withLocation(array, DataLocation::Storage, false));
+	Type const* tuple = TypeProvider::tuple({uint256, array});
+	Type const* typeType = TypeProvider::typeType(array);
+	Type const* rationalNumber = TypeProvider::rationalNumber(rational(7, 3));
+
+	TypeProvider::Statistics const statistics = TypeProvider::statistics();
+	BOOST_CHECK(statistics.createdTypes >= 10);
+
+	BOOST_CHECK(mapping == TypeProvider::mapping(uint256, TypeProvider::boolean()));
+	BOOST_CHECK(array == TypeProvider::array(DataLocation::Memory, uint256, 3));
+	BOOST_CHECK(storagePointer == TypeProvider::withLocation(array, DataLocation::Storage, true));
+	BOOST_CHECK(tuple == TypeProvider::tuple({uint256, array}));
+	BOOST_CHECK(typeType == TypeProvider::typeType(array));
+	BOOST_CHECK(rationalNumber == TypeProvider::rationalNumber(rational(7, 3)));
+
+	BOOST_CHECK_EQUAL(TypeProvider::statistics().createdTypes, statistics.createdTypes);
+	BOOST_CHECK_EQUAL(TypeProvider::statistics().reusedTypes, statistics.reusedTypes + 6);
+
+	TypeProvider::reset();
+	BOOST_CHECK_EQUAL(TypeProvider::statistics().createdTypes, 0);
+	BOOST_CHECK_EQUAL(TypeProvider::statistics().reusedTypes, 0);
+}
+
 BOOST_AUTO_TEST_CASE(helper_bool_result)
 {
 	BoolResult r1{true};
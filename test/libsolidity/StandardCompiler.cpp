@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -1234,6 +1235,37 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_separate_functions)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yul": true,
+				"yulDetails": { "separateFunctions": true }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint[] calldata x) external pure returns (uint) { return x[0]; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails["separateFunctions"].asBool() == true);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1755,6 +1787,115 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(output_selection_object_components)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint immutable x = 1; function f() public view returns (uint) { return x; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"A.sol": {
+					"A": ["abi", "evm.deployedBytecode.object", "evm.bytecode.sourceMap"]
+				}
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "A.sol", "A");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK((contract.getMemberNames() == vector<string>{"abi", "evm"}));
+	BOOST_CHECK((contract["evm"].getMemberNames() == vector<string>{"bytecode", "deployedBytecode"}));
+	BOOST_CHECK((contract["evm"]["bytecode"].getMemberNames() == vector<string>{"sourceMap"}));
+	BOOST_CHECK(!contract["evm"]["bytecode"]["sourceMap"].asString().empty());
+	BOOST_CHECK((contract["evm"]["deployedBytecode"].getMemberNames() == vector<string>{"object"}));
+	BOOST_CHECK(!contract["evm"]["deployedBytecode"]["object"].asString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	vector<string> inputs{
+		R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nlibrary L { function f(uint x) public pure returns (uint) { return x + 1; } }\ninterface I { event E(uint indexed a, string b); function g() external; }\ncontract A is I { uint immutable x = 7; function g() external override { emit E(L.f(x), \"\\u00e9\"); } }"
+				},
+				"B.sol": {
+					"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"A.sol\";\ncontract B { function h() public returns (A) { uint unused; return new A(); } }"
+				}
+			},
+			"settings": {
+				"outputSelection": {
+					"*": { "*": ["*"], "": ["ast"] },
+					"B.sol": { "B": ["abi"] }
+				}
+			}
+		}
+		)",
+		R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "contract A { function f() public { x = 1; } }" }
+			},
+			"settings": { "outputSelection": { "*": { "*": ["*"], "": ["ast"] } } }
+		}
+		)",
+		R"({ "language": "Solidity", "sources": { "A.sol": { "content": "contract A {}" } } })",
+		// Source names must not be mistaken for placeholders of the streamed output.
+		R"(
+		{
+			"language": "Solidity",
+			"sources": { "@errors": { "content": "contract A { function f() public { uint x; } }" } },
+			"settings": { "outputSelection": { "*": { "*": ["abi"], "": ["ast"] } } }
+		}
+		)",
+		R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"@contract": { "content": "contract A {}" },
+				"@node": { "content": "contract B {}" }
+			},
+			"settings": { "outputSelection": { "*": { "*": ["abi"], "": ["ast"] } } }
+		}
+		)",
+		// The analysis stops with an internal compiler error, the ASTs are written nevertheless.
+		R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "contract A { function f() internal virtual returns (uint); }\ncontract B is A { function f() internal override() returns (uint); }" }
+			},
+			"settings": { "parserErrorRecovery": true, "outputSelection": { "*": { "*": ["abi"], "": ["ast"] } } }
+		}
+		)",
+		R"({ "language": "Solidity", "sources": {} })",
+		"{ invalid json"
+	};
+	for (string const& input: inputs)
+	{
+		solidity::frontend::StandardCompiler compiler;
+		string output = compiler.compile(input);
+
+		solidity::frontend::StandardCompiler streamingCompiler;
+		ostringstream streamedOutput;
+		streamingCompiler.compile(input, streamedOutput);
+
+		BOOST_CHECK_EQUAL(streamedOutput.str(), output);
+		Json::Value parsedOutput;
+		BOOST_CHECK(util::jsonParseStrict(streamedOutput.str(), parsedOutput));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
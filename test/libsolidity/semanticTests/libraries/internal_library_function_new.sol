@@ -0,0 +1,19 @@
+contract C {
+  uint public x = 2;
+}
+
+library L {
+  function create() internal returns (C) {
+    return new C();
+  }
+}
+
+contract D {
+  function f() public returns (uint) {
+    return L.create().x();
+  }
+}
+// ====
+// compileViaYul: also
+// ----
+// f() -> 2
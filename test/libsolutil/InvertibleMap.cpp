@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the invertible map and relation.
+ */
+
+#include <libsolutil/InvertibleMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(InvertibleMapTest)
+
+BOOST_AUTO_TEST_CASE(map)
+{
+	InvertibleMap<string, string> m;
+	m.set("a", "x");
+	m.set("b", "x");
+	m.set("c", "y");
+	BOOST_CHECK((m.references.at("x") == set<string>{"a", "b"}));
+
+	m.set("a", "y");
+	BOOST_CHECK((m.references.at("x") == set<string>{"b"}));
+	BOOST_CHECK((m.references.at("y") == set<string>{"a", "c"}));
+
+	m.eraseValue("y");
+	BOOST_CHECK(m.values.find("b") && *m.values.find("b") == "x");
+	BOOST_CHECK(!m.values.count("a") && !m.values.count("c"));
+	BOOST_CHECK(!m.references.count("y"));
+
+	m.eraseKey("b");
+	m.eraseKey("d");
+	BOOST_CHECK(m.values.empty());
+	BOOST_CHECK(m.references.empty());
+}
+
+BOOST_AUTO_TEST_CASE(relation)
+{
+	InvertibleRelation<int> r;
+	r.set(1, {2, 3});
+	r.set(2, {3});
+	BOOST_CHECK((r.backward.at(3) == set<int>{1, 2}));
+	BOOST_CHECK((r.backward.at(2) == set<int>{1}));
+
+	r.set(1, {4});
+	BOOST_CHECK((r.backward.at(3) == set<int>{2}));
+	BOOST_CHECK(!r.backward.count(2));
+	BOOST_CHECK((r.backward.at(4) == set<int>{1}));
+
+	r.eraseKey(2);
+	r.eraseKey(5);
+	BOOST_CHECK((r.forward == std::map<int, set<int>>{{1, {4}}}));
+	BOOST_CHECK((r.backward == std::map<int, set<int>>{{4, {1}}}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,150 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the persistent map.
+ */
+
+#include <libsolutil/PersistentMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+std::map<int, int> toMap(PersistentMap<int, int> const& _map)
+{
+	std::map<int, int> result;
+	_map.forEach([&](int _key, int _value) { result[_key] = _value; });
+	return result;
+}
+
+vector<int> difference(PersistentMap<int, int> const& _map, PersistentMap<int, int> const& _other)
+{
+	vector<int> result;
+	_map.forEachDifference(_other, [&](int _key) { result.push_back(_key); });
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PersistentMapTest)
+
+BOOST_AUTO_TEST_CASE(basic)
+{
+	PersistentMap<int, int> m;
+	BOOST_CHECK(m.empty());
+	for (int i = 0; i < 100; ++i)
+		m.set((i * 37) % 100, i);
+	for (int i = 0; i < 100; ++i)
+		BOOST_REQUIRE(m.find((i * 37) % 100) && *m.find((i * 37) % 100) == i);
+	BOOST_CHECK(!m.count(100));
+
+	m.set(5, 1000);
+	BOOST_CHECK_EQUAL(*m.find(5), 1000);
+	for (int i = 0; i < 100; i += 2)
+		m.erase(i);
+	m.erase(1000);
+	std::map<int, int> values = toMap(m);
+	BOOST_CHECK_EQUAL(values.size(), 50);
+	BOOST_CHECK(values.begin()->first == 1 && values.rbegin()->first == 99);
+	BOOST_CHECK_EQUAL(values.at(5), 1000);
+
+	m.clear();
+	BOOST_CHECK(m.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ordered_iteration)
+{
+	PersistentMap<int, int> m;
+	for (int i: {7, 3, 9, 1, 5, 8, 2})
+		m.set(i, -i);
+	vector<int> keys;
+	m.forEach([&](int _key, int _value) {
+		BOOST_CHECK_EQUAL(_value, -_key);
+		keys.push_back(_key);
+	});
+	BOOST_CHECK((keys == vector<int>{1, 2, 3, 5, 7, 8, 9}));
+}
+
+BOOST_AUTO_TEST_CASE(copies_are_independent)
+{
+	PersistentMap<int, int> m;
+	for (int i = 0; i < 20; ++i)
+		m.set(i, i);
+	PersistentMap<int, int> snapshot = m;
+	m.set(3, 30);
+	m.erase(4);
+	m.set(25, 25);
+	BOOST_CHECK_EQUAL(*snapshot.find(3), 3);
+	BOOST_CHECK_EQUAL(*snapshot.find(4), 4);
+	BOOST_CHECK(!snapshot.count(25));
+	BOOST_CHECK_EQUAL(*m.find(3), 30);
+	BOOST_CHECK(!m.count(4));
+}
+
+BOOST_AUTO_TEST_CASE(difference_to_snapshot)
+{
+	PersistentMap<int, int> m;
+	for (int i = 0; i < 200; ++i)
+		m.set(i, i);
+	PersistentMap<int, int> snapshot = m;
+	BOOST_CHECK(difference(m, snapshot).empty());
+
+	m.set(10, 11);
+	m.erase(20);
+	m.set(300, 0);
+	m.set(30, 30);
+	BOOST_CHECK((difference(m, snapshot) == vector<int>{10, 300}));
+	BOOST_CHECK((difference(snapshot, m) == vector<int>{10, 20}));
+
+	// Setting a key back to its old value makes the maps equal again.
+	m.set(10, 10);
+	m.set(20, 20);
+	m.erase(300);
+	BOOST_CHECK(difference(m, snapshot).empty());
+	BOOST_CHECK(difference(snapshot, m).empty());
+}
+
+BOOST_AUTO_TEST_CASE(difference_independent_of_insertion_order)
+{
+	PersistentMap<int, int> a;
+	PersistentMap<int, int> b;
+	for (int i = 0; i < 50; ++i)
+	{
+		a.set(i, i);
+		b.set(49 - i, 49 - i);
+	}
+	b.set(17, 0);
+	BOOST_CHECK((difference(a, b) == vector<int>{17}));
+	BOOST_CHECK((difference(b, a) == vector<int>{17}));
+	BOOST_CHECK((difference(a, PersistentMap<int, int>{}).size() == 50));
+	BOOST_CHECK(difference(PersistentMap<int, int>{}, a).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(results_are_returned)
+{
+	for (size_t workerCount: vector<size_t>{0, 1, 4})
+	{
+		ThreadPool pool(workerCount);
+		vector<future<size_t>> results;
+		for (size_t i = 0; i < 100; ++i)
+			results.emplace_back(pool.submit([i]() { return i * i; }));
+		for (size_t i = 0; i < 100; ++i)
+			BOOST_CHECK_EQUAL(results[i].get(), i * i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_are_rethrown)
+{
+	ThreadPool pool(2);
+	future<void> result = pool.submit([]() { throw runtime_error("failure"); });
+	BOOST_CHECK_THROW(result.get(), runtime_error);
+	// The worker survives the exception.
+	BOOST_CHECK_EQUAL(pool.submit([]() { return 1; }).get(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(no_workers_run_in_calling_thread)
+{
+	ThreadPool pool(0);
+	BOOST_CHECK_EQUAL(pool.workerCount(), 0u);
+	BOOST_CHECK(pool.submit([]() { return this_thread::get_id(); }).get() == this_thread::get_id());
+}
+
+BOOST_AUTO_TEST_CASE(nested_tasks_do_not_deadlock)
+{
+	ThreadPool pool(1);
+	auto outer = pool.submit([&]() {
+		// The only worker waits for this task, so it has to be run right away.
+		return pool.submit([]() { return 2; }).get() + 1;
+	});
+	BOOST_CHECK_EQUAL(outer.get(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
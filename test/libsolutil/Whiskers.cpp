@@ -208,6 +208,25 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(same_template_rendered_repeatedly)
+{
+	string templ = "<a> <?c>x<!c>y</c> <#l>(<v>)</l>";
+	vector<map<string, string>> list(2);
+	list[0]["v"] = "1";
+	list[1]["v"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("c", true)("l", list).render(), "A x (1)(2)");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "B")("c", false)("l", vector<map<string, string>>{}).render(), "B y ");
+	Whiskers missingList(templ);
+	missingList("a", "A")("c", true);
+	BOOST_CHECK_THROW(missingList.render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(unmatched_brackets_are_text)
+{
+	string templ = "<<a>> <#l> <?c> </b> <!a> <a";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A").render(), "<A> <#l> <?c> </b> <!a> <a");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
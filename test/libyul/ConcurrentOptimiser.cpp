@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for applying function-local optimiser steps to functions separately and concurrently.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/Common.h>
+
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace
+{
+
+char const* source = R"({
+	function f(a, b) -> r {
+		for { let i := 0 } lt(i, a) { i := add(i, 1) } {
+			let t := mul(b, i)
+			if gt(t, 17) { t := sub(t, 3) }
+			r := add(r, t)
+			r := xor(r, sload(i))
+		}
+		sstore(a, r)
+		if lt(a, 3) { r := add(r, f(add(a, 1), b)) }
+	}
+	function g(x) -> y {
+		let t := sload(x)
+		y := add(f(x, t), f(add(x, 1), 7))
+		switch and(y, 3)
+		case 0 { y := div(y, 3) }
+		case 1 { y := mul(y, 5) t := add(t, y) }
+		default { y := add(y, t) }
+		if gt(y, 100) { y := div(y, 3) }
+		sstore(add(x, 100), t)
+		if lt(x, 2) { y := add(y, g(add(x, 1))) }
+	}
+	function h(x) -> y {
+		let a := mload(x)
+		let b := add(a, calldataload(x))
+		mstore(add(x, 32), b)
+		a := mload(add(x, 32))
+		switch x
+		case 0 { y := g(3) }
+		default { y := add(g(x), h(sub(x, 1))) y := add(y, a) }
+	}
+	sstore(0, 5)
+	sstore(10, h(4))
+	mstore(0, f(3, 4))
+	sstore(11, mload(0))
+})";
+
+EVMDialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+}
+
+shared_ptr<Object> optimise(bool _separately, bool _concurrently)
+{
+	ErrorList errors;
+	auto [object, analysisInfo] = yul::test::parse(source, evmDialect(), errors);
+	BOOST_REQUIRE(object && errors.empty());
+	object->analysisInfo = analysisInfo;
+	GasMeter meter(evmDialect(), false, 200);
+	OptimiserSuite::run(
+		evmDialect(),
+		&meter,
+		*object,
+		true,
+		frontend::OptimiserSettings::DefaultYulOptimiserSteps,
+		{},
+		_separately,
+		_concurrently
+	);
+	return object;
+}
+
+string interpret(Block const& _code)
+{
+	InterpreterState state;
+	state.maxTraceSize = 10000;
+	state.maxSteps = 1000000;
+	state.maxExprNesting = 64;
+	try
+	{
+		Interpreter::run(state, evmDialect(), _code);
+	}
+	catch (InterpreterTerminatedGeneric const&)
+	{
+	}
+
+	stringstream result;
+	state.dumpTraceAndState(result);
+	return result.str();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulConcurrentOptimiser)
+
+BOOST_AUTO_TEST_CASE(same_behaviour_as_whole_program)
+{
+	shared_ptr<Object> wholeProgram = optimise(false, false);
+	shared_ptr<Object> separate = optimise(true, true);
+	BOOST_CHECK_EQUAL(interpret(*separate->code), interpret(*wholeProgram->code));
+}
+
+BOOST_AUTO_TEST_CASE(concurrency_does_not_change_the_result)
+{
+	string sequential = AsmPrinter{}(*optimise(true, false)->code);
+	BOOST_CHECK_EQUAL(AsmPrinter{}(*optimise(true, true)->code), sequential);
+}
+
+BOOST_AUTO_TEST_CASE(deterministic)
+{
+	string first = AsmPrinter{}(*optimise(true, true)->code);
+	for (size_t i = 0; i < 5; ++i)
+		BOOST_CHECK_EQUAL(AsmPrinter{}(*optimise(true, true)->code), first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a{"interningTestA"};
+	YulString b{"interningTestB"};
+	BOOST_CHECK(a != b);
+	BOOST_CHECK(a == YulString{"interningTestA"});
+	BOOST_CHECK(YulString{} == YulString{""});
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(!a.empty());
+	BOOST_CHECK_EQUAL(a.str(), "interningTestA");
+	BOOST_CHECK_EQUAL(b.str(), "interningTestB");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("interningTestA"));
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	// Spans several chunks of the repository.
+	vector<YulString> strings;
+	for (size_t i = 0; i < 10000; ++i)
+		strings.emplace_back("manyStringsTest" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "manyStringsTest" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString{"manyStringsTest" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 8;
+	size_t const stringCount = 2000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("concurrentTest" + to_string((i + t * 7) % stringCount));
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t index = (i + t * 7) % stringCount;
+			YulString const& s = results[t][i];
+			BOOST_CHECK_EQUAL(s.str(), "concurrentTest" + to_string(index));
+			// All threads have to agree on the ID of the same string.
+			BOOST_CHECK(s == results[0][index]);
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -37,6 +37,7 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/algorithm/cxx11/all_of.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <variant>
 
@@ -47,28 +48,241 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+namespace
+{
+
+/**
+ * Resolves the variables to slots in the frames of their functions and the called
+ * functions to their definitions.
+ */
+class NameResolver: public ASTWalker
+{
+public:
+	NameResolver(Dialect const& _dialect, ResolvedNames& _names):
+		m_dialect(_dialect),
+		m_names(_names)
+	{}
+
+	void resolve(Block const& _ast)
+	{
+		m_frameSize = &m_names.frameSizes[nullptr];
+		(*this)(_ast);
+	}
+
+	void operator()(Identifier const& _identifier) override
+	{
+		for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+		{
+			if (auto slot = util::valueOrNullptr(scope->variables, _identifier.name))
+			{
+				m_names.referenceSlots[&_identifier] = *slot;
+				return;
+			}
+			if (scope->functionBody)
+				break;
+		}
+		yulAssert(false, "Variable not found: " + _identifier.name.str());
+	}
+
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		if (m_dialect.builtin(_funCall.functionName.name))
+			return;
+		for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+			if (auto function = util::valueOrNullptr(scope->functions, _funCall.functionName.name))
+			{
+				m_names.functions[&_funCall] = *function;
+				return;
+			}
+		yulAssert(false, "Function not found: " + _funCall.functionName.name.str());
+	}
+
+	void operator()(VariableDeclaration const& _declaration) override
+	{
+		ASTWalker::operator()(_declaration);
+		for (TypedName const& variable: _declaration.variables)
+			m_names.declarationSlots[&variable] = declare(variable);
+	}
+
+	void operator()(FunctionDefinition const& _function) override
+	{
+		size_t* outerFrameSize = m_frameSize;
+		m_frameSize = &m_names.frameSizes[&_function];
+
+		m_scopes.emplace_back(ScopeInfo{{}, {}, true});
+		for (TypedName const& parameter: _function.parameters)
+			declare(parameter);
+		for (TypedName const& returnVariable: _function.returnVariables)
+			declare(returnVariable);
+		(*this)(_function.body);
+		m_scopes.pop_back();
+
+		m_frameSize = outerFrameSize;
+	}
+
+	void operator()(ForLoop const& _forLoop) override
+	{
+		// The scope of the initialisation block extends over the whole loop.
+		m_scopes.emplace_back();
+		walkVector(_forLoop.pre.statements);
+		visit(*_forLoop.condition);
+		(*this)(_forLoop.body);
+		(*this)(_forLoop.post);
+		m_scopes.pop_back();
+	}
+
+	void operator()(Block const& _block) override
+	{
+		m_scopes.emplace_back();
+		for (auto const& statement: _block.statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+				m_scopes.back().functions[function->name] = function;
+		walkVector(_block.statements);
+		m_scopes.pop_back();
+	}
+
+private:
+	struct ScopeInfo
+	{
+		map<YulString, size_t> variables;
+		map<YulString, FunctionDefinition const*> functions;
+		/// Whether this is the outermost scope of a function, which variables
+		/// of enclosing scopes are not visible from.
+		bool functionBody = false;
+	};
+
+	size_t declare(TypedName const& _variable)
+	{
+		size_t slot = (*m_frameSize)++;
+		m_scopes.back().variables[_variable.name] = slot;
+		return slot;
+	}
+
+	Dialect const& m_dialect;
+	ResolvedNames& m_names;
+	vector<ScopeInfo> m_scopes;
+	/// Number of slots of the frame of the current function.
+	size_t* m_frameSize = nullptr;
+};
+
+}
+
+template <typename Function>
+void PagedMemory::forEachPage(u256 const& _offset, size_t _size, Function _function)
+{
+	u256 offset = _offset;
+	for (size_t done = 0; done < _size;)
+	{
+		size_t inPage = static_cast<size_t>(offset & u256(pageSize - 1));
+		size_t length = min(pageSize - inPage, _size - done);
+		_function(offset - inPage, inPage, done, length);
+		done += length;
+		// Wraps around at 2**256 like the offsets of single bytes.
+		offset += length;
+	}
+}
+
+uint8_t PagedMemory::byte(u256 const& _offset) const
+{
+	size_t inPage = static_cast<size_t>(_offset & u256(pageSize - 1));
+	Page const* page = findPage(_offset - inPage);
+	return page ? (*page)[inPage] : 0;
+}
+
+void PagedMemory::setByte(u256 const& _offset, uint8_t _value)
+{
+	size_t inPage = static_cast<size_t>(_offset & u256(pageSize - 1));
+	page(_offset - inPage)[inPage] = _value;
+}
+
+bytes PagedMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	forEachPage(_offset, _size, [&](u256 const& _pageOffset, size_t _inPage, size_t _dataOffset, size_t _length) {
+		if (Page const* page = findPage(_pageOffset))
+			copy_n(page->data() + _inPage, _length, data.data() + _dataOffset);
+	});
+	return data;
+}
+
+void PagedMemory::write(u256 const& _offset, bytes const& _data)
+{
+	forEachPage(_offset, _data.size(), [&](u256 const& _pageOffset, size_t _inPage, size_t _dataOffset, size_t _length) {
+		copy_n(_data.data() + _dataOffset, _length, page(_pageOffset).data() + _inPage);
+	});
+}
+
+u256 PagedMemory::readWord(u256 const& _offset) const
+{
+	size_t inPage = static_cast<size_t>(_offset & u256(pageSize - 1));
+	// Words within a single page, which includes all aligned words, are read directly.
+	if (inPage + 32 > pageSize)
+		return u256(h256(read(_offset, 32)));
+	Page const* page = findPage(_offset - inPage);
+	return page ? u256(h256(bytesConstRef(page->data() + inPage, 32))) : 0;
+}
+
+void PagedMemory::writeWord(u256 const& _offset, u256 const& _value)
+{
+	h256 word(_value);
+	size_t inPage = static_cast<size_t>(_offset & u256(pageSize - 1));
+	// Words within a single page, which includes all aligned words, are written directly.
+	if (inPage + 32 > pageSize)
+		write(_offset, word.asBytes());
+	else
+		copy_n(word.data(), 32, page(_offset - inPage).data() + inPage);
+}
+
+map<u256, h256> PagedMemory::nonZeroWords() const
+{
+	map<u256, h256> words;
+	for (auto const& [pageOffset, page]: m_pages)
+		for (size_t offset = 0; offset < pageSize; offset += 32)
+		{
+			h256 word(bytesConstRef(page.data() + offset, 32));
+			if (word != h256{})
+				words[pageOffset + offset] = word;
+		}
+	return words;
+}
+
+PagedMemory::Page const* PagedMemory::findPage(u256 const& _pageOffset) const
+{
+	auto it = m_pages.find(_pageOffset);
+	return it == m_pages.end() ? nullptr : &it->second;
+}
+
+PagedMemory::Page& PagedMemory::page(u256 const& _pageOffset)
+{
+	// Value-initialisation fills new pages with zeros.
+	return m_pages[_pageOffset];
+}
+
 void InterpreterState::dumpTraceAndState(ostream& _out) const
 {
 	_out << "Trace:" << endl;
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	for (auto const& [offset, value]: memory.nonZeroWords())
+		_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << value.hex() << endl;
 	_out << "Storage dump:" << endl;
+	vector<pair<h256, h256>> slots;
 	for (auto const& slot: storage)
 		if (slot.second != h256{})
-			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+			slots.emplace_back(slot);
+	sort(slots.begin(), slots.end());
+	for (auto const& [key, value]: slots)
+		_out << "  " << key.hex() << ": " << value.hex() << endl;
 }
 
 void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
 {
-	Scope scope;
-	Interpreter{_state, _dialect, scope}(_ast);
+	ResolvedNames names;
+	NameResolver{_dialect, names}.resolve(_ast);
+	vector<u256> frame(names.frameSizes.at(nullptr));
+	Interpreter{_state, _dialect, names, frame}(_ast);
 }
 
 void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
@@ -82,11 +296,7 @@ void Interpreter::operator()(Assignment const& _assignment)
 	vector<u256> values = evaluateMulti(*_assignment.value);
 	solAssert(values.size() == _assignment.variableNames.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-	}
+		m_frame[m_names.referenceSlots.at(&_assignment.variableNames.at(i))] = values.at(i);
 }
 
 void Interpreter::operator()(VariableDeclaration const& _declaration)
@@ -97,12 +307,7 @@ void Interpreter::operator()(VariableDeclaration const& _declaration)
 
 	solAssert(values.size() == _declaration.variables.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _declaration.variables.at(i).name;
-		solAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-		m_scope->names.emplace(varName, nullptr);
-	}
+		m_frame[m_names.declarationSlots.at(&_declaration.variables.at(i))] = values.at(i);
 }
 
 void Interpreter::operator()(If const& _if)
@@ -134,9 +339,6 @@ void Interpreter::operator()(ForLoop const& _forLoop)
 {
 	solAssert(_forLoop.condition, "");
 
-	enterScope(_forLoop.pre);
-	ScopeGuard g([this]{ leaveScope(); });
-
 	for (auto const& statement: _forLoop.pre.statements)
 	{
 		visit(statement);
@@ -181,15 +383,6 @@ void Interpreter::operator()(Leave const&)
 
 void Interpreter::operator()(Block const& _block)
 {
-	enterScope(_block);
-	// Register functions.
-	for (auto const& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
-		{
-			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
-			m_scope->names.emplace(funDef.name, &funDef);
-		}
-
 	for (auto const& statement: _block.statements)
 	{
 		incrementStep();
@@ -197,44 +390,22 @@ void Interpreter::operator()(Block const& _block)
 		if (m_state.controlFlowState != ControlFlowState::Default)
 			break;
 	}
-
-	leaveScope();
 }
 
 u256 Interpreter::evaluate(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
+	ExpressionEvaluator ev(m_state, m_dialect, m_names, m_frame);
 	ev.visit(_expression);
 	return ev.value();
 }
 
 vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
+	ExpressionEvaluator ev(m_state, m_dialect, m_names, m_frame);
 	ev.visit(_expression);
 	return ev.values();
 }
 
-void Interpreter::enterScope(Block const& _block)
-{
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = make_unique<Scope>(Scope{
-			{},
-			{},
-			m_scope
-		});
-	m_scope = m_scope->subScopes[&_block].get();
-}
-
-void Interpreter::leaveScope()
-{
-	for (auto const& [var, funDeclaration]: m_scope->names)
-		if (!funDeclaration)
-			m_variables.erase(var);
-	m_scope = m_scope->parent;
-	yulAssert(m_scope, "");
-}
-
 void Interpreter::incrementStep()
 {
 	m_state.numSteps++;
@@ -256,9 +427,8 @@ void ExpressionEvaluator::operator()(Literal const& _literal)
 
 void ExpressionEvaluator::operator()(Identifier const& _identifier)
 {
-	solAssert(m_variables.count(_identifier.name), "");
 	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	setValue(m_frame[m_names.referenceSlots.at(&_identifier)]);
 }
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
@@ -286,29 +456,19 @@ void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 			return;
 		}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
-			break;
-	yulAssert(scope, "");
-
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
-	yulAssert(fun, "Function not found.");
+	FunctionDefinition const* fun = m_names.functions.at(&_funCall);
 	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
-	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
-	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
+	// The parameters and return variables take the first slots of the frame.
+	vector<u256> frame(m_names.frameSizes.at(fun));
+	copy(m_values.begin(), m_values.end(), frame.begin());
 
 	m_state.controlFlowState = ControlFlowState::Default;
-	Interpreter interpreter(m_state, m_dialect, *scope, std::move(variables));
+	Interpreter interpreter(m_state, m_dialect, m_names, frame);
 	interpreter(fun->body);
 	m_state.controlFlowState = ControlFlowState::Default;
 
-	m_values.clear();
-	for (auto const& retVar: fun->returnVariables)
-		m_values.emplace_back(interpreter.valueOfVariable(retVar.name));
+	auto returnValues = frame.begin() + static_cast<ptrdiff_t>(fun->parameters.size());
+	m_values.assign(returnValues, returnValues + static_cast<ptrdiff_t>(fun->returnVariables.size()));
 }
 
 u256 ExpressionEvaluator::value() const
@@ -29,7 +29,12 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <array>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -67,14 +72,64 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Sparse memory that is allocated in pages of 4 KiB when they are first written to.
+ * Bytes that were never written are zero and offsets wrap around at 2**256.
+ */
+class PagedMemory
+{
+public:
+	/// @returns the byte at @a _offset.
+	uint8_t byte(u256 const& _offset) const;
+	/// Sets the byte at @a _offset.
+	void setByte(u256 const& _offset, uint8_t _value);
+	/// @returns the @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _data starting at @a _offset.
+	void write(u256 const& _offset, bytes const& _data);
+	/// @returns the 32 bytes starting at @a _offset as a big-endian number.
+	u256 readWord(u256 const& _offset) const;
+	/// Writes @a _value as a big-endian number to the 32 bytes starting at @a _offset.
+	void writeWord(u256 const& _offset, u256 const& _value);
+
+	/// @returns the 32 byte words that are not zero, by their offset.
+	std::map<u256, util::h256> nonZeroWords() const;
+
+private:
+	static size_t constexpr pageSize = 0x1000;
+	using Page = std::array<uint8_t, pageSize>;
+
+	/// @returns the page starting at @a _pageOffset or nullptr if it was never written to.
+	Page const* findPage(u256 const& _pageOffset) const;
+	/// @returns the page starting at @a _pageOffset, which is allocated if necessary.
+	Page& page(u256 const& _pageOffset);
+	/// Calls @a _function for each part of the @a _size bytes starting at @a _offset that lies
+	/// within a single page, with the offset of the page, the offset of the part within the page
+	/// and within the range, and the length of the part.
+	template <typename Function>
+	static void forEachPage(u256 const& _offset, size_t _size, Function _function);
+
+	/// Pages by the offset of their first byte.
+	std::map<u256, Page> m_pages;
+};
+
+/// Hash function for storage slots.
+struct StorageSlotHash
+{
+	size_t operator()(util::h256 const& _slot) const
+	{
+		return boost::hash_range(_slot.data(), _slot.data() + util::h256::size);
+	}
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	PagedMemory memory;
+	/// This is different than the size of the written memory because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
+	std::unordered_map<util::h256, util::h256, StorageSlotHash> storage;
 	u160 address = 0x11111111;
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
@@ -103,14 +158,21 @@ struct InterpreterState
 };
 
 /**
- * Scope structure built and maintained during execution.
+ * Variable slots and called functions, resolved before execution.
+ * Every variable has a slot in the frame of the function that declares it, where the
+ * parameters and return variables take the first slots. The code outside of functions
+ * has a frame of its own.
  */
-struct Scope
+struct ResolvedNames
 {
-	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
-	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
-	Scope* parent = nullptr;
+	/// Slots of the variables declared in variable declarations.
+	std::unordered_map<TypedName const*, size_t> declarationSlots;
+	/// Slots of the variables referenced by identifiers.
+	std::unordered_map<Identifier const*, size_t> referenceSlots;
+	/// Definitions of the called functions that are not builtins.
+	std::unordered_map<FunctionCall const*, FunctionDefinition const*> functions;
+	/// Number of slots of the frames of the functions, nullptr for the code outside of functions.
+	std::unordered_map<FunctionDefinition const*, size_t> frameSizes;
 };
 
 /**
@@ -124,13 +186,13 @@ public:
 	Interpreter(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> _variables = {}
+		ResolvedNames const& _names,
+		std::vector<u256>& _frame
 	):
 		m_dialect(_dialect),
 		m_state(_state),
-		m_variables(std::move(_variables)),
-		m_scope(&_scope)
+		m_names(_names),
+		m_frame(_frame)
 	{
 	}
 
@@ -148,26 +210,21 @@ public:
 
 	std::vector<std::string> const& trace() const { return m_state.trace; }
 
-	u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
-
 private:
 	/// Asserts that the expression evaluates to exactly one value and returns it.
 	u256 evaluate(Expression const& _expression);
 	/// Evaluates the expression and returns its value.
 	std::vector<u256> evaluateMulti(Expression const& _expression);
 
-	void enterScope(Block const& _block);
-	void leaveScope();
-
 	/// Increment interpreter step count, throwing exception if step limit
 	/// is reached.
 	void incrementStep();
 
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
-	/// Values of variables.
-	std::map<YulString, u256> m_variables;
-	Scope* m_scope;
+	ResolvedNames const& m_names;
+	/// Values of the variables of the current function, by their slots.
+	std::vector<u256>& m_frame;
 };
 
 /**
@@ -179,13 +236,13 @@ public:
 	ExpressionEvaluator(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables
+		ResolvedNames const& _names,
+		std::vector<u256> const& _frame
 	):
 		m_state(_state),
 		m_dialect(_dialect),
-		m_variables(_variables),
-		m_scope(_scope)
+		m_names(_names),
+		m_frame(_frame)
 	{}
 
 	void operator()(Literal const&) override;
@@ -214,9 +271,9 @@ private:
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
-	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
-	Scope& m_scope;
+	ResolvedNames const& m_names;
+	/// Values of the variables of the current function, by their slots.
+	std::vector<u256> const& m_frame;
 	/// Current value of the expression
 	std::vector<u256> m_values;
 	/// Current expression nesting level